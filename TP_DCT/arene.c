@@ -0,0 +1,176 @@
+#include "bases.h"
+#include "matrice.h"
+#include "arene.h"
+
+/*
+ * L'arène est une liste de blocs alignés.
+ * On emprunte dans le bloc courant, quand il est plein
+ * on passe au suivant (créé s'il n'existe pas).
+ * Les blocs ne sont jamais libérés avant "close_arene" :
+ * après le premier passage dans une boucle, ils suffisent.
+ */
+
+struct bloc_arene
+{
+  struct bloc_arene *suivant ;
+  size_t taille ;		/* Octets utilisables */
+  size_t utilise ;		/* Octets empruntés */
+  char *donnees ;
+} ;
+
+struct arene
+{
+  struct bloc_arene *premier ;
+  struct bloc_arene *courant ;
+} ;
+
+#define ARENE_TAILLE_SESSION 65536
+
+/*
+ * Arrondi au multiple de ALIGNEMENT supérieur
+ */
+#define ARRONDI(N) ( ((N) + ALIGNEMENT - 1) / ALIGNEMENT * ALIGNEMENT )
+
+static struct bloc_arene *nouveau_bloc(size_t taille)
+{
+  struct bloc_arene *b ;
+
+  ALLOUER(b, 1) ;
+  b->suivant = NULL ;
+  b->taille = ARRONDI(taille) ;
+  b->utilise = 0 ;
+  ALLOUER_ALIGNE(b->donnees, b->taille) ;
+  return b ;
+}
+
+struct arene* open_arene(size_t taille)
+{
+  struct arene *a ;
+
+  ALLOUER(a, 1) ;
+  a->premier = a->courant = nouveau_bloc(taille) ;
+  return a ;
+}
+
+void close_arene(struct arene *a)
+{
+  struct bloc_arene *b, *suivant ;
+
+  for(b=a->premier; b; b=suivant)
+    {
+      suivant = b->suivant ;
+      free(b->donnees) ;
+      free(b) ;
+    }
+  free(a) ;
+}
+
+/*
+ * Emprunte "taille" octets alignés
+ */
+static void *arene_octets(struct arene *a, size_t taille)
+{
+  void *p ;
+
+  taille = ARRONDI(taille) ;
+  while( a->courant->utilise + taille > a->courant->taille )
+    {
+      if ( a->courant->suivant == NULL )
+	a->courant->suivant = nouveau_bloc(MAX(taille, a->courant->taille)) ;
+      a->courant = a->courant->suivant ;
+      a->courant->utilise = 0 ;
+    }
+  p = a->courant->donnees + a->courant->utilise ;
+  a->courant->utilise += taille ;
+  return p ;
+}
+
+size_t arene_taille_matrice(int height, int width)
+{
+  return ARRONDI(sizeof(Matrice))
+    + ARRONDI(height * sizeof(float*))
+    + ARRONDI(height * PAS_ALIGNE(width, sizeof(float)) * sizeof(float)) ;
+}
+
+Matrice* arene_matrice(struct arene *a, int height, int width)
+{
+  Matrice *m ;
+  int j ;
+
+  /* La structure en premier : "arene_rend" repart de son adresse */
+  m = arene_octets(a, sizeof(*m)) ;
+  m->width = width ;
+  m->height = height ;
+  m->pas = PAS_ALIGNE(width, sizeof(float)) ;
+  m->t = arene_octets(a, height * sizeof(*m->t)) ;
+  m->donnees = arene_octets(a, height * m->pas * sizeof(*m->donnees)) ;
+  for(j=0; j<height; j++)
+    m->t[j] = MATRICE_LIGNE(m, j) ;
+  return m ;
+}
+
+void arene_rend(struct arene *a, Matrice *m)
+{
+  struct bloc_arene *b ;
+  char *p = (char*)m ;
+
+  for(b=a->premier; b; b=b->suivant)
+    if ( p >= b->donnees && p < b->donnees + b->taille )
+      {
+	b->utilise = p - b->donnees ;
+	a->courant = b ;
+	return ;
+      }
+  EXIT ; /* La matrice ne vient pas de cette arène */
+}
+
+Vue arene_vue(struct arene *a, const Matrice *m, Matrice **copie)
+{
+  int j ;
+
+  if ( m->donnees )
+    {
+      *copie = NULL ;
+      return vue_matrice(m, 0, 0, m->height, m->width) ;
+    }
+  *copie = arene_matrice(a, m->height, m->width) ;
+  for(j=0; j<m->height; j++)
+    memcpy((*copie)->t[j], m->t[j], m->width * sizeof(float)) ;
+  return vue_matrice(*copie, 0, 0, m->height, m->width) ;
+}
+
+void arene_rend_vue(struct arene *a, Matrice *copie, Matrice *destination)
+{
+  int j ;
+
+  if ( copie == NULL )
+    return ;
+  if ( destination )
+    for(j=0; j<copie->height; j++)
+      memcpy(destination->t[j], copie->t[j], copie->width * sizeof(float)) ;
+  arene_rend(a, copie) ;
+}
+
+void arene_reserve(struct arene *a, size_t taille)
+{
+  struct bloc_arene *b ;
+
+  taille = ARRONDI(taille) ;
+  if ( a->courant->utilise + taille <= a->courant->taille )
+    return ;
+  if ( a->courant->suivant && a->courant->suivant->taille >= taille )
+    return ;
+  /* On insère un bloc assez grand juste après le bloc courant */
+  b = nouveau_bloc(taille) ;
+  b->suivant = a->courant->suivant ;
+  a->courant->suivant = b ;
+}
+
+struct arene* arene_session()
+{
+  static __thread struct arene *session = NULL ;
+
+  if ( session == NULL )
+    session = open_arene(ARENE_TAILLE_SESSION) ;
+  return session ;
+}
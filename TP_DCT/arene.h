@@ -0,0 +1,53 @@
+/*
+ * Arène de matrices temporaires.
+ *
+ * Les fonctions de calcul empruntent leurs matrices de travail
+ * à une arène au lieu de les allouer. L'arène est une pile :
+ * rendre une matrice rend aussi toutes celles empruntées après elle.
+ * Une fois l'arène assez grande, emprunter et rendre ne font
+ * plus aucun appel à "malloc" ni à "free".
+ */
+
+#ifndef ARENE_H
+#define ARENE_H
+
+#include "matrice.h"
+
+struct arene ;
+
+struct arene* open_arene(size_t taille) ;
+void close_arene(struct arene *a) ;
+/*
+ * Nombre d'octets d'arène utilisés par une matrice
+ */
+size_t arene_taille_matrice(int height, int width) ;
+/*
+ * Les matrices empruntées ont la même disposition que celles
+ * de "allocation_matrice_float" mais leur contenu n'est pas initialisé.
+ * Il ne faut pas les libérer avec "liberation_matrice_float".
+ */
+Matrice* arene_matrice(struct arene *a, int height, int width) ;
+void arene_rend(struct arene *a, Matrice *m) ;
+/*
+ * Vue sur toute la matrice "m". Si ses lignes ne sont pas dans un
+ * bloc unique (matrice construite à la main), elles sont recopiées
+ * dans une matrice empruntée, retournée dans "*copie" (NULL sinon).
+ */
+Vue arene_vue(struct arene *a, const Matrice *m, Matrice **copie) ;
+/*
+ * Rend la copie (si non NULL) après l'avoir recopiée dans
+ * "destination" (si non NULL).
+ */
+void arene_rend_vue(struct arene *a, Matrice *copie, Matrice *destination) ;
+/*
+ * Garantit que les "taille" octets suivants pourront être empruntés
+ * sans allocation. A appeler une fois par image avant les boucles.
+ */
+void arene_reserve(struct arene *a, size_t taille) ;
+/*
+ * L'arène propre au thread appelant, créée au premier appel
+ * et jamais libérée.
+ */
+struct arene* arene_session() ;
+
+#endif
@@ -0,0 +1,282 @@
+#include "bases.h"
+#include "matrice.h"
+#include "arene.h"
+#include "jpg.h"
+#include "ondelette.h"
+
+/*
+ * Vérifie qu'une matrice empruntée est utilisable
+ */
+static int matrice_ok(const Matrice *m, int height, int width)
+{
+  int i, j ;
+
+  if ( m->height != height || m->width != width )
+    {
+      eprintf("Matrice %dx%d au lieu de %dx%d\n", m->height, m->width
+	      , height, width) ;
+      return 0 ;
+    }
+  if ( m->pas < m->width || (m->pas * sizeof(float)) % ALIGNEMENT )
+    {
+      eprintf("Le pas (%d) n'est pas aligné\n", m->pas) ;
+      return 0 ;
+    }
+  for(j=0; j<height; j++)
+    if ( m->t[j] != MATRICE_LIGNE(m, j) || (size_t)m->t[j] % ALIGNEMENT )
+      {
+	eprintf("La ligne %d est mal placée\n", j) ;
+	return 0 ;
+      }
+  for(j=0; j<height; j++)
+    for(i=0; i<width; i++)
+      m->t[j][i] = 1000*j + i ;
+  return 1 ;
+}
+
+void open_arene_tst()
+{
+  struct arene *a ;
+  Matrice *m1, *m2 ;
+  int i, j ;
+
+  a = open_arene(1000) ;
+  m1 = arene_matrice(a, 5, 7) ;
+  m2 = arene_matrice(a, 50, 70) ; /* Ne tient pas dans le premier bloc */
+  if ( !matrice_ok(m1, 5, 7) || !matrice_ok(m2, 50, 70) )
+    return ;
+  for(j=0; j<m2->height; j++)
+    for(i=0; i<m2->width; i++)
+      m2->t[j][i] = -1 ;
+  for(j=0; j<m1->height; j++)
+    for(i=0; i<m1->width; i++)
+      if ( m1->t[j][i] != 1000*j + i )
+	{
+	  eprintf("Les matrices empruntées se chevauchent\n") ;
+	  return ;
+	}
+  close_arene(a) ;
+}
+
+void close_arene_tst()
+{
+  struct arene *a ;
+
+  a = open_arene(1000) ;
+  arene_matrice(a, 50, 70) ;
+  close_arene(a) ;
+
+  if ( open_arene(1000) != a )
+    {
+      eprintf("Vous êtes sûr de tout libérer ?\n") ;
+      return ;
+    }
+}
+
+void arene_taille_matrice_tst()
+{
+  struct arene *a ;
+  long avant ;
+
+  a = open_arene(arene_taille_matrice(17, 33) + arene_taille_matrice(3, 1)) ;
+  avant = nb_allocations ;
+  arene_matrice(a, 17, 33) ;
+  arene_matrice(a, 3, 1) ;
+  if ( nb_allocations != avant )
+    {
+      eprintf("arene_taille_matrice est trop petite\n") ;
+      return ;
+    }
+  close_arene(a) ;
+}
+
+void arene_matrice_tst()
+{
+  struct arene *a ;
+  Matrice *m ;
+  long avant ;
+  int n ;
+
+  a = open_arene(100) ;
+  avant = 0 ;
+  for(n=0; n<10; n++)
+    {
+      if ( n == 1 ) /* Le premier tour agrandit l'arène */
+	avant = nb_allocations ;
+      m = arene_matrice(a, 10, 10) ;
+      if ( !matrice_ok(m, 10, 10) || !matrice_ok(arene_matrice(a, 20, 3), 20, 3) )
+	return ;
+      arene_rend(a, m) ;
+    }
+  if ( nb_allocations != avant )
+    {
+      eprintf("%ld allocations dans la boucle\n", nb_allocations - avant) ;
+      return ;
+    }
+  close_arene(a) ;
+}
+
+void arene_rend_tst()
+{
+  struct arene *a ;
+  Matrice *m1, *m2, *m3 ;
+
+  a = open_arene(100000) ;
+  m1 = arene_matrice(a, 10, 10) ;
+  m2 = arene_matrice(a, 10, 10) ;
+  arene_rend(a, m2) ;
+  m3 = arene_matrice(a, 10, 10) ;
+  if ( m3 != m2 )
+    {
+      eprintf("La matrice rendue n'est pas réutilisée\n") ;
+      return ;
+    }
+  arene_rend(a, m1) ; /* Rend aussi m3 */
+  if ( arene_matrice(a, 20, 20) != m1 )
+    {
+      eprintf("Rendre une matrice doit rendre les suivantes\n") ;
+      return ;
+    }
+  close_arene(a) ;
+}
+
+void arene_reserve_tst()
+{
+  struct arene *a ;
+  Matrice *m ;
+  long avant ;
+
+  a = open_arene(100) ;
+  m = arene_matrice(a, 1, 1) ;
+  arene_reserve(a, 3*arene_taille_matrice(40, 40)) ;
+  avant = nb_allocations ;
+  arene_matrice(a, 40, 40) ;
+  arene_matrice(a, 40, 40) ;
+  arene_matrice(a, 40, 40) ;
+  if ( nb_allocations != avant )
+    {
+      eprintf("Allocation après arene_reserve\n") ;
+      return ;
+    }
+  arene_rend(a, m) ;
+  close_arene(a) ;
+}
+
+/*
+ * Une matrice construite à la main : lignes séparées
+ */
+static float l1[3] = { 1, 2, 3 } ;
+static float l2[3] = { 4, 5, 6 } ;
+static float *lignes[] = { l1, l2 } ;
+static Matrice a_la_main = { 3, 2, lignes } ;
+
+void arene_vue_tst()
+{
+  struct arene *a ;
+  Matrice *m, *copie ;
+  Vue v ;
+
+  a = open_arene(1000) ;
+  m = allocation_matrice_float(4, 5) ;
+  v = arene_vue(a, m, &copie) ;
+  if ( copie != NULL || v.base != m->t[0] || v.pas != m->pas
+       || v.height != 4 || v.width != 5 )
+    {
+      eprintf("Une matrice allouée ne doit pas être copiée\n") ;
+      return ;
+    }
+  liberation_matrice_float(m) ;
+
+  v = arene_vue(a, &a_la_main, &copie) ;
+  if ( copie == NULL || v.height != 2 || v.width != 3
+       || VUE_LIGNE(&v, 1)[2] != 6 || VUE_LIGNE(&v, 0)[0] != 1 )
+    {
+      eprintf("La copie de la matrice est fausse\n") ;
+      return ;
+    }
+  arene_rend_vue(a, copie, NULL) ;
+  close_arene(a) ;
+}
+
+void arene_rend_vue_tst()
+{
+  struct arene *a ;
+  Matrice *copie ;
+  Vue v ;
+
+  a = open_arene(1000) ;
+  v = arene_vue(a, &a_la_main, &copie) ;
+  VUE_LIGNE(&v, 1)[0] = 40 ;
+  arene_rend_vue(a, copie, NULL) ;
+  if ( l2[0] != 4 )
+    {
+      eprintf("Sans destination, il ne faut pas recopier\n") ;
+      return ;
+    }
+  v = arene_vue(a, &a_la_main, &copie) ;
+  VUE_LIGNE(&v, 1)[0] = 40 ;
+  arene_rend_vue(a, copie, &a_la_main) ;
+  if ( l2[0] != 40 )
+    {
+      eprintf("La vue n'est pas recopiée dans la destination\n") ;
+      return ;
+    }
+  l2[0] = 4 ;
+  if ( arene_matrice(a, 1, 1) != copie )
+    {
+      eprintf("La copie n'est pas rendue à l'arène\n") ;
+      return ;
+    }
+  arene_rend_vue(a, NULL, &a_la_main) ; /* Ne fait rien */
+  close_arene(a) ;
+}
+
+/*
+ * Les fonctions de calcul ne doivent plus allouer
+ * une fois l'arène de session dimensionnée.
+ */
+void arene_session_tst()
+{
+  Matrice *m ;
+  long avant ;
+  int n ;
+
+  if ( arene_session() != arene_session() )
+    {
+      eprintf("L'arène de session doit être unique\n") ;
+      return ;
+    }
+
+  m = allocation_matrice_float(16, 16) ;
+  matrice_ok(m, 16, 16) ;
+  avant = 0 ;
+  for(n=0; n<5; n++)
+    {
+      if ( n == 1 )
+	avant = nb_allocations ;
+      dct_image(0, 16, m) ;
+      dct_image(1, 16, m) ;
+    }
+  if ( nb_allocations != avant )
+    {
+      eprintf("dct_image fait %ld allocations\n", nb_allocations - avant) ;
+      return ;
+    }
+  liberation_matrice_float(m) ;
+
+  m = allocation_matrice_float(37, 50) ;
+  matrice_ok(m, 37, 50) ;
+  for(n=0; n<3; n++)
+    {
+      if ( n == 1 )
+	avant = nb_allocations ;
+      ondelette_2d(m) ;
+      ondelette_2d_inverse(m) ;
+    }
+  if ( nb_allocations != avant )
+    {
+      eprintf("L'ondelette fait %ld allocations\n", nb_allocations - avant) ;
+      return ;
+    }
+  liberation_matrice_float(m) ;
+}
@@ -16,16 +16,40 @@
  * Sortie du programme
  */
 #define EXIT do { ICI ; abort() ; } while(0)
+/*
+ * Nombre d'allocations faites par ALLOUER et ALLOUER_ALIGNE
+ * depuis le lancement du programme (défini dans "eprintf.c").
+ * Les tests l'utilisent pour vérifier qu'une boucle n'alloue rien.
+ */
+extern long nb_allocations ;
+#define COMPTE_ALLOCATION __atomic_add_fetch(&nb_allocations, 1, __ATOMIC_RELAXED)
 /*
  * Allocation mémoire. L'exemple alloue un tableau de 10 éléments :
  *
  * struct toto *a ;
  * ALLOUER(a, 10) ;
  */
-#define ALLOUER(X,NB) do if ( (X = malloc(sizeof(*(X)) * (NB))) == 0 )\
+#define ALLOUER(X,NB) do if ( COMPTE_ALLOCATION, \
+                              (X = malloc(sizeof(*(X)) * (NB))) == 0 )\
                              { fprintf(stderr, "Plus de memoire\n") ; \
                                 EXIT ; } \
                       while(0)
+/*
+ * Comme ALLOUER mais l'adresse retournée est alignée sur ALIGNEMENT
+ * octets (une ligne de cache, un registre AVX-512).
+ * On libère avec "free".
+ */
+#define ALIGNEMENT 64
+#define ALLOUER_ALIGNE(X,NB) do if ( COMPTE_ALLOCATION, posix_memalign((void**)&(X), ALIGNEMENT,\
+                                                    sizeof(*(X))*MAX((NB),1)) )\
+                             { fprintf(stderr, "Plus de memoire\n") ; \
+                                EXIT ; } \
+                      while(0)
+/*
+ * Arrondi de N au multiple de ALIGNEMENT octets supérieur
+ * pour des éléments de taille T.
+ */
+#define PAS_ALIGNE(N,T) ( ((N)*(T) + ALIGNEMENT - 1) / ALIGNEMENT * ALIGNEMENT / (T) )
 /*
  * Donne le nombre d'éléments d'un tableau
  */
@@ -44,6 +68,10 @@
 #define MAX(A,B) ( (A)>=(B) ? (A) : (B) )
 #endif
 
+#ifndef MIN
+#define MIN(A,B) ( (A)<=(B) ? (A) : (B) )
+#endif
+
 /*
  * "printf" sur "stderr" au lieu de "stdout"
  * NE L'UTILISEZ PAS pour debugger cela perturberait les tests
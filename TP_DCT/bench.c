@@ -0,0 +1,803 @@
+#include <time.h>
+#include "bases.h"
+#include "matrice.h"
+#include "simd.h"
+#include "pool.h"
+#include "dct.h"
+#include "mdct.h"
+#include "psycho.h"
+#include "bitstream.h"
+#include "intstream.h"
+#include "rle.h"
+#include "jpg.h"
+#include "bench.h"
+
+/*
+ * Programme de mesure :
+
+export BENCH=produit  # ou "transposition", "threads", "dct", "bande", "elaguee", "creuse", "mdct", "psycho", "rle". Sans BENCH toutes les mesures sont faites
+./bench
+
+ * Chaque mesure répète le calcul assez de fois pour durer
+ * environ DUREE secondes et affiche le temps d'un calcul.
+ */
+
+#define DUREE 0.2
+
+double chrono()
+{
+  struct timespec t ;
+
+  clock_gettime(CLOCK_MONOTONIC, &t) ;
+  return t.tv_sec + t.tv_nsec * 1e-9 ;
+}
+
+/*
+ * Temps moyen d'un appel de "f(donnees)" en secondes.
+ */
+static double mesure(void (*f)(void *), void *donnees)
+{
+  double debut, t ;
+  long n, nb ;
+
+  nb = 1 ;
+  for(;;)
+    {
+      debut = chrono() ;
+      for(n=0; n<nb; n++)
+	(*f)(donnees) ;
+      t = chrono() - debut ;
+      if ( t > DUREE )
+	return t / nb ;
+      nb *= 2 ;
+    }
+}
+
+static void remplit_matrice(Matrice *m)
+{
+  int i, j ;
+
+  for(j=0; j<m->height; j++)
+    for(i=0; i<m->width; i++)
+      m->t[j][i] = cos(j*m->width + i) ;
+}
+
+/*
+ *****************************************************************************
+ * Produit de matrices
+ *****************************************************************************
+ */
+
+struct produit
+{
+  Matrice *a, *b, *r ;
+} ;
+
+/*
+ * Le produit d'origine : triple boucle avec lecture de "b" par colonnes
+ */
+static void produit_reference(void *d)
+{
+  struct produit *p = d ;
+  int j, i, k ;
+  float s ;
+
+  for(j=0; j<p->a->height; j++)
+    for(i=0; i<p->b->width; i++)
+      {
+	s = 0 ;
+	for(k=0; k<p->a->width; k++)
+	  s += p->a->t[j][k] * p->b->t[k][i] ;
+	p->r->t[j][i] = s ;
+      }
+}
+
+static void produit(void *d)
+{
+  struct produit *p = d ;
+
+  produit_matrices_float(p->a, p->b, p->r) ;
+}
+
+static void bench_produit()
+{
+  static int tailles[] = { 8, 32, 128, 710 } ;
+  struct produit p ;
+  double flop ;
+  int i, n, max ;
+
+  max = simd_niveau() ;
+  printf("Produit de matrices carrées (GFlop/s)\n") ;
+  printf("%6s %12s", "Taille", "reference") ;
+  for(n=Simd_scalaire; n<=max; n++)
+    printf(" %12s", simd_noms[n]) ;
+  printf("\n") ;
+
+  for(i=0; i<TAILLE(tailles); i++)
+    {
+      p.a = allocation_matrice_float(tailles[i], tailles[i]) ;
+      p.b = allocation_matrice_float(tailles[i], tailles[i]) ;
+      p.r = allocation_matrice_float(tailles[i], tailles[i]) ;
+      remplit_matrice(p.a) ;
+      remplit_matrice(p.b) ;
+      flop = 2. * tailles[i] * tailles[i] * tailles[i] ;
+
+      printf("%6d %12.2f", tailles[i]
+	     , flop / mesure(produit_reference, &p) * 1e-9) ;
+      for(n=Simd_scalaire; n<=max; n++)
+	{
+	  simd_force(n) ;
+	  printf(" %12.2f", flop / mesure(produit, &p) * 1e-9) ;
+	}
+      simd_force(max) ;
+      printf("\n") ;
+      fflush(stdout) ;
+
+      liberation_matrice_float(p.a) ;
+      liberation_matrice_float(p.b) ;
+      liberation_matrice_float(p.r) ;
+    }
+}
+
+/*
+ *****************************************************************************
+ * Transposition
+ *****************************************************************************
+ */
+
+struct transposition
+{
+  Matrice *a, *r ;
+} ;
+
+/*
+ * La transposition d'origine : double boucle avec lecture de "a" par colonnes
+ */
+static void transposition_reference(void *d)
+{
+  struct transposition *t = d ;
+  int j, i ;
+
+  for(j=0; j<t->r->height; j++)
+    for(i=0; i<t->r->width; i++)
+      t->r->t[j][i] = t->a->t[i][j] ;
+}
+
+static void transposition(void *d)
+{
+  struct transposition *t = d ;
+
+  transposition_matrice(t->a, t->r) ;
+}
+
+static void bench_transposition()
+{
+  static int tailles[][2] = { {512, 512}, {1024, 1024}, {2048, 2048},
+			      {3000, 4000}, {4096, 4096} } ;
+  struct transposition t ;
+  double octets ;
+  int i, n, max ;
+
+  max = simd_niveau() ;
+  printf("Transposition (Go/s lus et écrits)\n") ;
+  printf("%11s %12s", "Taille", "reference") ;
+  for(n=Simd_scalaire; n<=max; n++)
+    printf(" %12s", simd_noms[n]) ;
+  printf("\n") ;
+
+  for(i=0; i<TAILLE(tailles); i++)
+    {
+      t.a = allocation_matrice_float(tailles[i][0], tailles[i][1]) ;
+      t.r = allocation_matrice_float(tailles[i][1], tailles[i][0]) ;
+      remplit_matrice(t.a) ;
+      octets = 2. * sizeof(float) * tailles[i][0] * tailles[i][1] ;
+
+      printf("%5dx%-5d %12.2f", tailles[i][0], tailles[i][1]
+	     , octets / mesure(transposition_reference, &t) * 1e-9) ;
+      for(n=Simd_scalaire; n<=max; n++)
+	{
+	  simd_force(n) ;
+	  printf(" %12.2f", octets / mesure(transposition, &t) * 1e-9) ;
+	}
+      simd_force(max) ;
+      printf("\n") ;
+      fflush(stdout) ;
+
+      liberation_matrice_float(t.a) ;
+      liberation_matrice_float(t.r) ;
+    }
+}
+
+/*
+ *****************************************************************************
+ * Passage à l'échelle des versions parallèles, de 1 à THREADS threads
+ *****************************************************************************
+ */
+
+struct vecteur
+{
+  Matrice *a ;
+  float *v, *r ;
+} ;
+
+static void vecteur(void *d)
+{
+  struct vecteur *v = d ;
+
+  produit_matrice_vecteur(v->a, v->v, v->r) ;
+}
+
+static void bench_threads()
+{
+  struct produit p ;
+  struct transposition t ;
+  struct vecteur v ;
+  double tp, tt, tv, tp1, tt1, tv1 ;
+  int n, max ;
+
+  max = pool_nb_threads() ;
+  p.a = allocation_matrice_float(1024, 1024) ;
+  p.b = allocation_matrice_float(1024, 1024) ;
+  p.r = allocation_matrice_float(1024, 1024) ;
+  t.a = allocation_matrice_float(4096, 4096) ;
+  t.r = allocation_matrice_float(4096, 4096) ;
+  v.a = t.a ;
+  ALLOUER(v.v, 4096) ;
+  ALLOUER(v.r, 4096) ;
+  remplit_matrice(p.a) ;
+  remplit_matrice(p.b) ;
+  remplit_matrice(t.a) ;
+  memset(v.v, 0, 4096 * sizeof(*v.v)) ;
+
+  printf("Threads (temps en ms et accélération)\n") ;
+  printf("%7s %19s %19s %19s\n", "Threads", "produit 1024"
+	 , "transposition 4096", "vecteur 4096") ;
+  tp1 = tt1 = tv1 = 0 ;
+  for(n=1; n<=max; n++)
+    {
+      pool_limite(n) ;
+      tp = mesure(produit, &p) ;
+      tt = mesure(transposition, &t) ;
+      tv = mesure(vecteur, &v) ;
+      if ( n == 1 )
+	{
+	  tp1 = tp ;
+	  tt1 = tt ;
+	  tv1 = tv ;
+	}
+      printf("%7d %12.2f x%5.2f %12.2f x%5.2f %12.2f x%5.2f\n", n
+	     , tp*1e3, tp1/tp, tt*1e3, tt1/tt, tv*1e3, tv1/tv) ;
+      fflush(stdout) ;
+    }
+  pool_limite(0) ;
+
+  liberation_matrice_float(p.a) ;
+  liberation_matrice_float(p.b) ;
+  liberation_matrice_float(p.r) ;
+  liberation_matrice_float(t.a) ;
+  liberation_matrice_float(t.r) ;
+  free(v.v) ;
+  free(v.r) ;
+}
+
+/*
+ *****************************************************************************
+ * DCT d'un vecteur : produit par la matrice du plan ou FFT
+ *****************************************************************************
+ */
+
+struct dct
+{
+  const struct dct_plan *plan ;
+  const Matrice *m ;
+  float *v, *r ;
+} ;
+
+static void dct_matrice(void *d)
+{
+  struct dct *p = d ;
+
+  produit_matrice_vecteur(p->m, p->v, p->r) ;
+}
+
+static void dct_plan_rapide(void *d)
+{
+  struct dct *p = d ;
+
+  dct_plan_applique(p->plan, 0, p->v, p->r) ;
+}
+
+static void bench_dct()
+{
+  struct dct p ;
+  double tm, tr ;
+  int n, i ;
+
+  printf("DCT d'un vecteur (temps en microsecondes)\n") ;
+  printf("%6s %12s %12s %12s\n", "Taille", "matrice", "rapide", "gain") ;
+  for(n=8; n<=4096; n*=2)
+    {
+      p.plan = dct_plan(n) ;
+      p.m = dct_plan_matrice(p.plan, 0) ;
+      ALLOUER(p.v, n) ;
+      ALLOUER(p.r, n) ;
+      for(i=0; i<n; i++)
+	p.v[i] = cos(i) ;
+      tm = mesure(dct_matrice, &p) ;
+      tr = mesure(dct_plan_rapide, &p) ;
+      printf("%6d %12.3f %12.3f %11.1fx\n", n, tm*1e6, tr*1e6, tm/tr) ;
+      fflush(stdout) ;
+      free(p.v) ;
+      free(p.r) ;
+    }
+}
+
+/*
+ *****************************************************************************
+ * DCT d'une bande de blocs d'image (chemin de "imagedct")
+ *****************************************************************************
+ */
+
+struct bande
+{
+  int nbe ;
+  Matrice *m ;
+} ;
+
+static void bande(void *d)
+{
+  struct bande *b = d ;
+  Vue v ;
+
+  v = vue_matrice(b->m, 0, 0, b->nbe, b->m->width) ;
+  dct_bande(0, b->nbe, &v) ;
+  dct_bande(1, b->nbe, &v) ;
+}
+
+static void bench_bande()
+{
+  static int tailles[] = { 8, 16, 32 } ;
+  struct bande b ;
+  int i, n, max ;
+
+  max = simd_niveau() ;
+  printf("DCT + inverse d'une bande de 64 blocs (ns par bloc)\n") ;
+  printf("%6s", "Taille") ;
+  for(n=Simd_scalaire; n<=max; n++)
+    printf(" %12s", simd_noms[n]) ;
+  printf("\n") ;
+
+  for(i=0; i<TAILLE(tailles); i++)
+    {
+      b.nbe = tailles[i] ;
+      b.m = allocation_matrice_float(b.nbe, 64 * b.nbe) ;
+      remplit_matrice(b.m) ;
+      printf("%6d", b.nbe) ;
+      for(n=Simd_scalaire; n<=max; n++)
+	{
+	  simd_force(n) ;
+	  printf(" %12.1f", mesure(bande, &b) / 64 * 1e9) ;
+	}
+      simd_force(max) ;
+      printf("\n") ;
+      fflush(stdout) ;
+      liberation_matrice_float(b.m) ;
+    }
+}
+
+/*
+ *****************************************************************************
+ * DCT élaguée : seules les "coupure" premières cases du zigzag
+ *****************************************************************************
+ */
+
+struct elaguee
+{
+  int nbe ;
+  Matrice *source, *m ;
+  int *longueurs ;
+} ;
+
+/*
+ * On repart toujours des mêmes blocs : sinon les coefficients
+ * effacés font tendre les valeurs vers des nombres dénormalisés.
+ */
+static void elaguee(void *d)
+{
+  struct elaguee *e = d ;
+  Vue v ;
+  int j ;
+
+  for(j=0; j<e->nbe; j++)
+    memcpy(e->m->t[j], e->source->t[j], e->m->width * sizeof(float)) ;
+  v = vue_matrice(e->m, 0, 0, e->nbe, e->m->width) ;
+  if ( e->longueurs )
+    dct_elaguee_bande(e->nbe, e->longueurs, &v) ;
+  else
+    dct_bande(0, e->nbe, &v) ;
+}
+
+static void bench_elaguee()
+{
+  static int tailles[] = { 8, 16, 32 } ;
+  static int fractions[] = { 2, 4, 16, 64 } ;
+  struct elaguee e ;
+  int i, f ;
+
+  printf("Copie et DCT d'une bande de 64 blocs (ns par bloc)\n") ;
+  printf("%6s %12s", "Taille", "complète") ;
+  for(f=0; f<TAILLE(fractions); f++)
+    printf("      coupure=1/%-2d", fractions[f]) ;
+  printf("\n") ;
+
+  for(i=0; i<TAILLE(tailles); i++)
+    {
+      e.nbe = tailles[i] ;
+      e.source = allocation_matrice_float(e.nbe, 64 * e.nbe) ;
+      e.m = allocation_matrice_float(e.nbe, 64 * e.nbe) ;
+      remplit_matrice(e.source) ;
+      printf("%6d", e.nbe) ;
+      e.longueurs = NULL ;
+      printf(" %12.1f", mesure(elaguee, &e) / 64 * 1e9) ;
+      ALLOUER(e.longueurs, e.nbe) ;
+      for(f=0; f<TAILLE(fractions); f++)
+	{
+	  dct_masque(e.nbe, 0, MAX(1, e.nbe * e.nbe / fractions[f]),
+		     e.longueurs) ;
+	  printf(" %18.1f", mesure(elaguee, &e) / 64 * 1e9) ;
+	}
+      printf("\n") ;
+      fflush(stdout) ;
+      free(e.longueurs) ;
+      liberation_matrice_float(e.source) ;
+      liberation_matrice_float(e.m) ;
+    }
+}
+
+/*
+ *****************************************************************************
+ * DCT inverse de blocs dont seul le carré s x s en haut à gauche
+ * est non nul (chemins creux).
+ *****************************************************************************
+ */
+
+static void inverse(void *d)
+{
+  struct elaguee *e = d ;
+  Vue v ;
+  int j ;
+
+  for(j=0; j<e->nbe; j++)
+    memcpy(e->m->t[j], e->source->t[j], e->m->width * sizeof(float)) ;
+  v = vue_matrice(e->m, 0, 0, e->nbe, e->m->width) ;
+  dct_bande(1, e->nbe, &v) ;
+}
+
+static void bench_creuse()
+{
+  static int tailles[] = { 8, 16, 32 } ;
+  static int carres[] = { 1, 2, 4, 0 } ;
+  struct elaguee e ;
+  int i, c, s, j, x ;
+
+  printf("Copie et DCT inverse d'une bande de 64 blocs (ns par bloc)\n") ;
+  printf("%6s %12s %12s %12s %12s\n", "Taille", "continu", "2x2", "4x4", "complète") ;
+
+  for(i=0; i<TAILLE(tailles); i++)
+    {
+      e.nbe = tailles[i] ;
+      e.source = allocation_matrice_float(e.nbe, 64 * e.nbe) ;
+      e.m = allocation_matrice_float(e.nbe, 64 * e.nbe) ;
+      printf("%6d", e.nbe) ;
+      for(c=0; c<TAILLE(carres); c++)
+	{
+	  s = carres[c] ? carres[c] : e.nbe ;
+	  remplit_matrice(e.source) ;
+	  for(j=0; j<e.nbe; j++)
+	    for(x=0; x<e.source->width; x++)
+	      if ( j >= s || x % e.nbe >= s )
+		e.source->t[j][x] = 0 ;
+	  printf(" %12.1f", mesure(inverse, &e) / 64 * 1e9) ;
+	}
+      printf("\n") ;
+      fflush(stdout) ;
+      liberation_matrice_float(e.source) ;
+      liberation_matrice_float(e.m) ;
+    }
+}
+
+/*
+ *****************************************************************************
+ * Son entier : DCT par blocs indépendants ou MDCT (aller-retour)
+ *****************************************************************************
+ */
+
+#define SON "DONNEES/spiderman.raw"
+
+struct son
+{
+  int nbe ;
+  int nb ;			/* Multiple de nbe */
+  float *echantillons, *coefficients, *sortie ;
+} ;
+
+/*
+ * Le son en octets, NULL (avec un message) s'il manque.
+ */
+static unsigned char *lit_son(int *taille)
+{
+  unsigned char *octets ;
+  FILE *f ;
+
+  f = fopen(SON, "r") ;
+  if ( f == NULL )
+    {
+      printf("Pas de fichier %s\n", SON) ;
+      return NULL ;
+    }
+  fseek(f, 0, SEEK_END) ;
+  *taille = ftell(f) ;
+  rewind(f) ;
+  ALLOUER(octets, *taille) ;
+  assert(fread(octets, 1, *taille, f) == *taille) ;
+  fclose(f) ;
+  return octets ;
+}
+
+static void son_dct(void *d)
+{
+  struct son *s = d ;
+  int i ;
+
+  for(i=0; i<s->nb; i+=s->nbe)
+    {
+      dct(0, s->nbe, s->echantillons + i, s->coefficients + i) ;
+      dct(1, s->nbe, s->coefficients + i, s->sortie + i) ;
+    }
+}
+
+static void son_mdct(void *d)
+{
+  struct son *s = d ;
+  struct mdct *directe, *inverse ;
+  int i ;
+
+  directe = open_mdct(s->nbe) ;
+  inverse = open_mdct(s->nbe) ;
+  for(i=0; i<s->nb; i+=s->nbe)
+    {
+      mdct(directe, 0, s->echantillons + i, s->coefficients + i) ;
+      mdct(inverse, 1, s->coefficients + i, s->sortie + i) ;
+    }
+  close_mdct(directe) ;
+  close_mdct(inverse) ;
+}
+
+static void bench_mdct()
+{
+  static int tailles[] = { 128, 256, 1024 } ;
+  struct son s ;
+  unsigned char *octets ;
+  int i, j, taille ;
+  double td, tm ;
+
+  octets = lit_son(&taille) ;
+  if ( octets == NULL )
+    return ;
+
+  printf("Aller-retour sur %s (millions d'échantillons par seconde)\n", SON) ;
+  printf("%6s %12s %12s\n", "Taille", "dct", "mdct") ;
+  for(i=0; i<TAILLE(tailles); i++)
+    {
+      s.nbe = tailles[i] ;
+      s.nb = taille / s.nbe * s.nbe ;
+      ALLOUER(s.echantillons, s.nb) ;
+      ALLOUER(s.coefficients, s.nb) ;
+      ALLOUER(s.sortie, s.nb) ;
+      for(j=0; j<s.nb; j++)
+	s.echantillons[j] = octets[j] - 128. ;
+      td = mesure(son_dct, &s) ;
+      tm = mesure(son_mdct, &s) ;
+      printf("%6d %12.1f %12.1f\n", s.nbe, s.nb / td * 1e-6, s.nb / tm * 1e-6) ;
+      fflush(stdout) ;
+      free(s.echantillons) ;
+      free(s.coefficients) ;
+      free(s.sortie) ;
+    }
+  free(octets) ;
+}
+
+/*
+ *****************************************************************************
+ * Masquage "psycho" de toutes les trames du son : paires, élagué ou Bark
+ *****************************************************************************
+ */
+
+static void son_psycho(void *d, void (*f)(int, float*, float))
+{
+  struct son *s = d ;
+  int i ;
+
+  memcpy(s->sortie, s->coefficients, s->nb * sizeof(*s->sortie)) ;
+  for(i=0; i<s->nb; i+=s->nbe)
+    (*f)(s->nbe, s->sortie + i, 1) ;
+}
+
+static void psycho_bark_4000(int nbe, float *dct, float c)
+{
+  psycho_bark(nbe, dct, c, 4000) ;
+}
+
+static void son_psycho_paires(void *d) { son_psycho(d, psycho_paires) ; }
+static void son_psycho_elague(void *d) { son_psycho(d, psycho) ; }
+static void son_psycho_bark(void *d) { son_psycho(d, psycho_bark_4000) ; }
+
+static void bench_psycho()
+{
+  static int tailles[] = { 128, 1024, 4096 } ;
+  struct son s ;
+  unsigned char *octets ;
+  int i, j, taille ;
+  double tp, te, tb ;
+
+  octets = lit_son(&taille) ;
+  if ( octets == NULL )
+    return ;
+
+  printf("Masquage de %s (millions de coefficients par seconde)\n", SON) ;
+  printf("%6s %12s %12s %12s\n", "Taille", "paires", "psycho", "bark") ;
+  for(i=0; i<TAILLE(tailles); i++)
+    {
+      s.nbe = tailles[i] ;
+      s.nb = taille / s.nbe * s.nbe ;
+      ALLOUER(s.echantillons, s.nb) ;
+      ALLOUER(s.coefficients, s.nb) ;
+      ALLOUER(s.sortie, s.nb) ;
+      for(j=0; j<s.nb; j++)
+	s.echantillons[j] = octets[j] - 128. ;
+      for(j=0; j<s.nb; j+=s.nbe)
+	dct(0, s.nbe, s.echantillons + j, s.coefficients + j) ;
+      tp = mesure(son_psycho_paires, &s) ;
+      te = mesure(son_psycho_elague, &s) ;
+      tb = mesure(son_psycho_bark, &s) ;
+      printf("%6d %12.2f %12.2f %12.2f\n", s.nbe, s.nb / tp * 1e-6,
+	     s.nb / te * 1e-6, s.nb / tb * 1e-6) ;
+      fflush(stdout) ;
+      free(s.echantillons) ;
+      free(s.coefficients) ;
+      free(s.sortie) ;
+    }
+  free(octets) ;
+}
+
+/*
+ *****************************************************************************
+ * RLE des trames du son après "psycho" (beaucoup de zéros)
+ *****************************************************************************
+ */
+
+struct rle
+{
+  struct son son ;
+  struct intstream *entier, *entier_signe ;
+} ;
+
+/* La boucle d'origine de "compresse" */
+static void rle_reference(void *d)
+{
+  struct rle *r = d ;
+  unsigned count ;
+  int i, k, var ;
+
+  for(i=0; i<r->son.nb; i+=r->son.nbe)
+    {
+      count = 0 ;
+      for(k=i; k<i+r->son.nbe; k++)
+	{
+	  var = roundf(r->son.coefficients[k]) ;
+	  if ( var == 0 )
+	    count++ ;
+	  else
+	    {
+	      put_entier_intstream(r->entier, count) ;
+	      put_entier_intstream(r->entier_signe, var) ;
+	      count = 0 ;
+	    }
+	}
+      if ( count )
+	put_entier_intstream(r->entier, count) ;
+    }
+}
+
+static void rle(void *d)
+{
+  struct rle *r = d ;
+  int i ;
+
+  for(i=0; i<r->son.nb; i+=r->son.nbe)
+    compresse(r->entier, r->entier_signe, r->son.nbe,
+	      r->son.coefficients + i) ;
+}
+
+static void bench_rle()
+{
+  static int tailles[] = { 128, 1024 } ;
+  struct bitstream *bs ;
+  struct rle r ;
+  unsigned char *octets ;
+  int i, j, n, max, taille ;
+
+  octets = lit_son(&taille) ;
+  if ( octets == NULL )
+    return ;
+  bs = open_bitstream("/dev/null", "w") ;
+  r.entier = open_intstream(bs, Entier, NULL) ;
+  r.entier_signe = open_intstream(bs, Entier_Signe, NULL) ;
+
+  max = simd_niveau() ;
+  printf("RLE de %s après psycho (millions de coefficients par seconde)\n"
+	 , SON) ;
+  printf("%6s %12s", "Taille", "reference") ;
+  for(n=Simd_scalaire; n<=max; n++)
+    printf(" %12s", simd_noms[n]) ;
+  printf("\n") ;
+  for(i=0; i<TAILLE(tailles); i++)
+    {
+      r.son.nbe = tailles[i] ;
+      r.son.nb = taille / r.son.nbe * r.son.nbe ;
+      ALLOUER(r.son.echantillons, r.son.nb) ;
+      ALLOUER(r.son.coefficients, r.son.nb) ;
+      for(j=0; j<r.son.nb; j++)
+	r.son.echantillons[j] = octets[j] - 128. ;
+      for(j=0; j<r.son.nb; j+=r.son.nbe)
+	{
+	  dct(0, r.son.nbe, r.son.echantillons + j, r.son.coefficients + j) ;
+	  psycho(r.son.nbe, r.son.coefficients + j, 1) ;
+	}
+      printf("%6d %12.1f", r.son.nbe
+	     , r.son.nb / mesure(rle_reference, &r) * 1e-6) ;
+      for(n=Simd_scalaire; n<=max; n++)
+	{
+	  simd_force(n) ;
+	  printf(" %12.1f", r.son.nb / mesure(rle, &r) * 1e-6) ;
+	}
+      simd_force(max) ;
+      printf("\n") ;
+      fflush(stdout) ;
+      free(r.son.echantillons) ;
+      free(r.son.coefficients) ;
+    }
+  close_bitstream(bs) ;
+  close_intstream(r.entier) ;
+  close_intstream(r.entier_signe) ;
+  free(octets) ;
+}
+
+/*
+ *****************************************************************************
+ */
+
+void bench(const char *nom)
+{
+  static struct { const char *nom ; void (*f)() ; } mesures[] =
+    {
+      { "produit", bench_produit },
+      { "transposition", bench_transposition },
+      { "threads", bench_threads },
+      { "dct", bench_dct },
+      { "bande", bench_bande },
+      { "elaguee", bench_elaguee },
+      { "creuse", bench_creuse },
+      { "mdct", bench_mdct },
+      { "psycho", bench_psycho },
+      { "rle", bench_rle },
+    } ;
+  int i ;
+
+  for(i=0; i<TAILLE(mesures); i++)
+    if ( nom == NULL || strcmp(nom, mesures[i].nom) == 0 )
+      {
+	(*mesures[i].f)() ;
+	printf("\n") ;
+      }
+}
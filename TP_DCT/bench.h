@@ -0,0 +1,16 @@
+/*
+ * Mesures de performances des noyaux de calcul.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+/*
+ * Lance la mesure "nom" ou toutes les mesures si "nom" est NULL.
+ * Les résultats sont affichés sur la sortie standard.
+ */
+void bench(const char *nom) ;
+
+double chrono() ;
+
+#endif
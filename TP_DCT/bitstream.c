@@ -76,6 +76,22 @@ struct bitstream *open_bitstream(const char *fichier, const char* mode)
     return b;
 }
 
+/*
+ * Comme "open_bitstream" mais sur un fichier déjà ouvert
+ * (par exemple avec "open_memstream" ou "fmemopen").
+ * Le fichier sera fermé par "close_bitstream".
+ */
+
+struct bitstream *open_bitstream_file(FILE *f, const char* mode)
+{
+    struct bitstream* b;
+    ALLOUER(b, 1);
+    b->ecriture = mode[0] != 'r';
+    b->fichier = f;
+    b->nb_bits_dans_buffer = 0;
+    return b;
+}
+
 /*
  * Cette fonction ne fait rien si le fichier est ouvert en lecture.
  * 
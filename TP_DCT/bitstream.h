@@ -26,6 +26,8 @@ void              close_bitstream(struct bitstream *b) ;
 void                      put_bit(struct bitstream *b, Booleen bit) ;
 Booleen 	          get_bit(struct bitstream *b) ;
 
+struct bitstream *open_bitstream_file(FILE *f, const char* mode) ; /**/
+
 FILE          *bitstream_get_file(const struct bitstream *b) ; /**/
 Booleen     bitstream_en_ecriture(const struct bitstream *b) ; /**/
 int bitstream_nb_bits_dans_buffer(const struct bitstream *b) ; /**/
@@ -1,6 +1,9 @@
+#include <pthread.h>
 #include "bases.h"
 #include "matrice.h"
 #include "dct.h"
+#include "fft.h"
+#include "arene.h"
 
 /*
  * La fonction calculant les coefficients de la DCT (et donc de l'inverse)
@@ -32,11 +35,203 @@ void coef_dct(Matrice *table)
 	}
 }
 
+/*
+ * Un plan contient les coefficients d'une taille de DCT
+ * et ceux de son inverse (la transposée).
+ *
+ * Pour les puissances de 2 (à partir de DCT_FFT_MIN), la DCT
+ * est calculée par une FFT en O(n log n) (algorithme de Makhoul) :
+ *
+ *   v[k] = x[2k], v[n-1-k] = x[2k+1]         (k < n/2)
+ *   V = FFT(v)
+ *   X[k] = s(k) * Re( exp(-i pi k / 2n) V[k] )
+ *
+ * avec s(0) = sqrt(1/n) et s(k) = sqrt(2/n) comme dans "coef_dct".
+ * L'inverse refait le chemin à l'envers :
+ *
+ *   V[k] = exp(i pi k / 2n) (X[k] - i X[n-k]) / (n s(k))   (X[n] = 0)
+ *   v = FFT inverse(V)
+ *   x[2k] = Re(v[k]), x[2k+1] = Re(v[n-1-k])
+ */
+
+static void facteurs_rapides(struct dct_plan *plan)
+{
+	int n = plan->nbe, k;
+	double s;
+	double complex r;
+
+	plan->fft = open_fft(n);
+	ALLOUER(plan->facteurs_directe, 2*n);
+	ALLOUER(plan->facteurs_inverse, 2*n);
+	for (k = 0; k < n; k++) {
+		s = k == 0 ? sqrt(1. / n) : sqrt(2. / n);
+		r = cexp(-I * M_PI * k / (2 * n));
+		plan->facteurs_directe[2*k] = creal(r) * s;
+		plan->facteurs_directe[2*k+1] = cimag(r) * s;
+		plan->facteurs_inverse[2*k] = creal(r) / (n * s);
+		plan->facteurs_inverse[2*k+1] = -cimag(r) / (n * s);
+	}
+}
+
+/*
+ * Les matrices sont publiées une fois calculées,
+ * "directe" en dernier.
+ */
+static void calcule_matrices(struct dct_plan *plan)
+{
+	Matrice *directe, *inverse;
+
+	directe = allocation_matrice_float(plan->nbe, plan->nbe);
+	inverse = allocation_matrice_float(plan->nbe, plan->nbe);
+	coef_dct(directe);
+	transposition_matrice(directe, inverse);
+	__atomic_store_n(&plan->inverse, inverse, __ATOMIC_RELEASE);
+	__atomic_store_n(&plan->directe, directe, __ATOMIC_RELEASE);
+}
+
+struct dct_plan* open_dct_plan(int nbe)
+{
+	struct dct_plan *plan;
+
+	ALLOUER(plan, 1);
+	plan->nbe = nbe;
+	plan->directe = plan->inverse = NULL;
+	plan->suivant = NULL;
+	plan->fft = NULL;
+	plan->facteurs_directe = plan->facteurs_inverse = NULL;
+	if (puissance_de_2(nbe) && nbe >= DCT_FFT_MIN)
+		facteurs_rapides(plan);
+	else
+		calcule_matrices(plan);
+	return plan;
+}
+
+void close_dct_plan(struct dct_plan *plan)
+{
+	if (plan->fft) {
+		free(plan->facteurs_inverse);
+		free(plan->facteurs_directe);
+		close_fft(plan->fft);
+	}
+	if (plan->directe) {
+		liberation_matrice_float(plan->inverse);
+		liberation_matrice_float(plan->directe);
+	}
+	free(plan);
+}
+
+/*
+ * Cache des plans : une liste où l'on ne fait qu'ajouter en tête.
+ * La lecture se fait sans verrou, un plan n'est publié
+ * qu'une fois complètement calculé.
+ * Le verrou évite que deux threads calculent le même plan.
+ */
+
+static struct dct_plan *plans = NULL;
+static pthread_mutex_t verrou_plans = PTHREAD_MUTEX_INITIALIZER;
+
+static const struct dct_plan* cherche_plan(int nbe)
+{
+	const struct dct_plan *plan;
+
+	for(plan = __atomic_load_n(&plans, __ATOMIC_ACQUIRE);
+	    plan; plan = plan->suivant)
+		if (plan->nbe == nbe)
+			return plan;
+	return NULL;
+}
+
+const struct dct_plan* dct_plan(int nbe)
+{
+	const struct dct_plan *plan;
+	struct dct_plan *nouveau;
+
+	plan = cherche_plan(nbe);
+	if (plan)
+		return plan;
+
+	pthread_mutex_lock(&verrou_plans);
+	plan = cherche_plan(nbe);
+	if (plan == NULL) {
+		nouveau = open_dct_plan(nbe);
+		nouveau->suivant = plans;
+		__atomic_store_n(&plans, nouveau, __ATOMIC_RELEASE);
+		plan = nouveau;
+	}
+	pthread_mutex_unlock(&verrou_plans);
+	return plan;
+}
+
+/*
+ * n² cosinus : un plan FFT ne les calcule qu'à la première demande.
+ */
+const Matrice* dct_plan_matrice(const struct dct_plan *plan, int inverse)
+{
+	struct dct_plan *p = (struct dct_plan*)plan;
+	Matrice *m;
+
+	m = __atomic_load_n(inverse ? &p->inverse : &p->directe,
+			    __ATOMIC_ACQUIRE);
+	if (m)
+		return m;
+	pthread_mutex_lock(&verrou_plans);
+	if (p->directe == NULL)
+		calcule_matrices(p);
+	pthread_mutex_unlock(&verrou_plans);
+	return inverse ? p->inverse : p->directe;
+}
+
+static void dct_rapide(const struct dct_plan *plan, int inverse,
+		       const float *entree, float *sortie)
+{
+	struct arene *arene = arene_session();
+	Matrice *tampon = arene_matrice(arene, 1, 2 * plan->nbe);
+	float complex *v = (float complex*)tampon->t[0];
+	const float complex *f;
+	int n = plan->nbe, k;
+
+	if (!inverse) {
+		f = (const float complex*)plan->facteurs_directe;
+		for (k = 0; k < n/2; k++) {
+			v[k] = entree[2*k];
+			v[n-1-k] = entree[2*k+1];
+		}
+		fft(plan->fft, v, 0);
+		for (k = 0; k < n; k++)
+			sortie[k] = crealf(PRODUIT_COMPLEXE(f[k], v[k]));
+	}
+	else {
+		f = (const float complex*)plan->facteurs_inverse;
+		v[0] = crealf(f[0]) * entree[0];
+		for (k = 1; k < n; k++)
+			v[k] = PRODUIT_COMPLEXE(f[k],
+						CMPLXF(entree[k], -entree[n-k]));
+		fft(plan->fft, v, 1);
+		for (k = 0; k < n/2; k++) {
+			sortie[2*k] = crealf(v[k]);
+			sortie[2*k+1] = crealf(v[n-1-k]);
+		}
+	}
+	arene_rend(arene, tampon);
+}
+
+void dct_plan_applique(const struct dct_plan *plan, int inverse,
+		       const float *entree, float *sortie)
+{
+	if (plan->fft)
+		dct_rapide(plan, inverse, entree, sortie);
+	else
+		produit_matrice_vecteur(inverse ? plan->inverse : plan->directe,
+					entree, sortie);
+}
+
 /*
  * La fonction calculant la DCT ou son inverse.
  *
  * Cette fonction va être appelée très souvent pour faire
  * la DCT du son ou de l'image (nombreux paquets).
+ * Les coefficients viennent du cache de plans :
+ * ils ne sont calculés qu'une fois par taille.
  */
 
 void dct(int   inverse,		/* ==0: DCT, !=0 DCT inverse */
@@ -45,20 +240,5 @@ void dct(int   inverse,		/* ==0: DCT, !=0 DCT inverse */
 	 float *sortie		/* Le son après transformation */
 	 )
 {
-	static Matrice *dct = NULL;
-	static Matrice * tmp = NULL;
-	if(dct == NULL){
-		dct = allocation_matrice_float(nbe, nbe);
-		tmp = allocation_matrice_float(nbe, nbe);
-		coef_dct(dct);
-		transposition_matrice(dct, tmp);
-	}	
-
-	if(inverse) {
-		produit_matrice_vecteur(tmp, entree, sortie);
-	}
-	else {
-		produit_matrice_vecteur(dct, entree, sortie);
-	}
-	
+	dct_plan_applique(dct_plan(nbe), inverse, entree, sortie);
 }
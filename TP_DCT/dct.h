@@ -4,4 +4,49 @@
 void coef_dct(Matrice *table) ;
 void dct(int inverse, int nbe, const float *entree, float *sortie ) ;
 
+/*
+ * Coefficients précalculés d'une DCT de taille "nbe"
+ */
+struct fft ;
+
+/*
+ * En dessous de cette taille le produit par la matrice est plus rapide.
+ */
+#define DCT_FFT_MIN 32
+
+struct dct_plan
+{
+  int nbe ;
+  /*
+   * Calculées à l'ouverture sans FFT, sinon NULL jusqu'au premier
+   * "dct_plan_matrice" : ne les lire que par cette fonction.
+   */
+  Matrice *directe ;		/* DCT */
+  Matrice *inverse ;		/* DCT inverse : la transposée */
+  /*
+   * Si nbe est une puissance de 2 d'au moins DCT_FFT_MIN,
+   * la DCT d'un vecteur passe par une FFT de taille nbe
+   * (sinon "fft" est NULL).
+   * Facteurs complexes (partie réelle puis imaginaire)
+   * appliqués après la FFT directe et avant la FFT inverse.
+   */
+  struct fft *fft ;
+  float *facteurs_directe ;
+  float *facteurs_inverse ;
+  struct dct_plan *suivant ;	/* Pour le cache */
+} ;
+
+struct dct_plan* open_dct_plan(int nbe) ;
+void close_dct_plan(struct dct_plan *plan) ;
+/*
+ * Le plan partagé pour la taille "nbe", créé au premier appel.
+ * Utilisable depuis plusieurs threads, il ne faut pas le libérer.
+ */
+const struct dct_plan* dct_plan(int nbe) ;
+void dct_plan_applique(const struct dct_plan *plan, int inverse, const float *entree, float *sortie) ;
+/*
+ * Matrice de la DCT (ou de son inverse) pour les produits matriciels.
+ */
+const Matrice* dct_plan_matrice(const struct dct_plan *plan, int inverse) ;
+
 #endif
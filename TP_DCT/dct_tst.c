@@ -1,14 +1,11 @@
+#include <pthread.h>
 #include "bases.h"
 #include "matrice.h"
 #include "dct.h"
 
 #define NBE 5
 
-void coef_dct_tst()
-{
-  Matrice *table ;
-  int i, j ;
-  static float t[NBE][NBE] =
+static float t[NBE][NBE] =
   {
     { 0.447214, 0.447214, 0.447214   , 0.447214, 0.447214},
     { 0.601501, 0.371748, 3.87265e-17,-0.371748,-0.601501},
@@ -17,6 +14,11 @@ void coef_dct_tst()
     { 0.19544 ,-0.511667, 0.632456   ,-0.511667, 0.19544 },
   } ;
 
+void coef_dct_tst()
+{
+  Matrice *table ;
+  int i, j ;
+
 
   table = allocation_matrice_float(NBE, NBE) ;
   coef_dct(table) ;
@@ -85,3 +87,225 @@ void dct_tst()
       }
 }
 
+
+void open_dct_plan_tst()
+{
+  struct dct_plan *plan ;
+  int i, j ;
+
+  plan = open_dct_plan(NBE) ;
+  if ( plan->nbe != NBE )
+    {
+      eprintf("Le plan a la taille %d au lieu de %d\n", plan->nbe, NBE) ;
+      return ;
+    }
+  for(j=0; j<NBE; j++)
+    for(i=0; i<NBE; i++)
+      if ( fabs(plan->directe->t[j][i] - t[j][i]) > 0.0001
+	   || plan->inverse->t[i][j] != plan->directe->t[j][i] )
+	{
+	  eprintf("Coefficients du plan faux en [%d][%d]\n", j, i) ;
+	  return ;
+	}
+  close_dct_plan(plan) ;
+}
+
+void close_dct_plan_tst()
+{
+  struct dct_plan *plan ;
+
+  plan = open_dct_plan(NBE) ;
+  close_dct_plan(plan) ;
+  if ( open_dct_plan(NBE) != plan )
+    {
+      eprintf("Vous êtes sûr de tout libérer ?\n") ;
+      return ;
+    }
+}
+
+/*
+ * Pour les puissances de 2, le chemin par FFT doit donner
+ * le même résultat que le produit par la matrice.
+ */
+#define GRAND 1024
+
+static void dct_rapide_tst()
+{
+  struct dct_plan *plan ;
+  static float entree[GRAND], sortie[GRAND], attendu[GRAND] ;
+  int n, i, inverse ;
+
+  plan = open_dct_plan(DCT_FFT_MIN - 1) ;
+  if ( plan->fft )
+    {
+      eprintf("Pas de FFT pour une taille %d\n", DCT_FFT_MIN - 1) ;
+      return ;
+    }
+  close_dct_plan(plan) ;
+
+  for(n=DCT_FFT_MIN; n<=GRAND; n*=2)
+    {
+      plan = open_dct_plan(n) ;
+      if ( plan->fft == NULL )
+	{
+	  eprintf("Il faut une FFT pour la taille %d\n", n) ;
+	  return ;
+	}
+      for(i=0; i<n; i++)
+	entree[i] = (i * 37) % 256 - 128 ;
+      for(inverse=0; inverse<2; inverse++)
+	{
+	  produit_matrice_vecteur(dct_plan_matrice(plan, inverse),
+				  entree, attendu) ;
+	  dct_plan_applique(plan, inverse, entree, sortie) ;
+	  for(i=0; i<n; i++)
+	    if ( fabs(sortie[i] - attendu[i]) > 0.001 * (1 + fabs(attendu[i])) )
+	      {
+		eprintf("n=%d inverse=%d : [%d] = %g au lieu de %g\n"
+			, n, inverse, i, sortie[i], attendu[i]) ;
+		return ;
+	      }
+	}
+      close_dct_plan(plan) ;
+    }
+}
+
+void dct_plan_applique_tst()
+{
+  struct dct_plan *plan ;
+  float entree[NBE] = { 1, 2, 3, 4, 5 }, sortie[NBE], retour[NBE] ;
+  double s ;
+  int i, j ;
+
+  plan = open_dct_plan(NBE) ;
+  dct_plan_applique(plan, 0, entree, sortie) ;
+  for(j=0; j<NBE; j++)
+    {
+      s = 0 ;
+      for(i=0; i<NBE; i++)
+	s += t[j][i] * entree[i] ;
+      if ( fabs(sortie[j] - s) > 0.001 )
+	{
+	  eprintf("sortie[%d] = %g au lieu de %g\n", j, sortie[j], s) ;
+	  return ;
+	}
+    }
+  dct_plan_applique(plan, 1, sortie, retour) ;
+  for(i=0; i<NBE; i++)
+    if ( fabs(retour[i] - entree[i]) > 0.001 )
+      {
+	eprintf("inverse[%d] = %g au lieu de %g\n", i, retour[i], entree[i]) ;
+	return ;
+      }
+  close_dct_plan(plan) ;
+  dct_rapide_tst() ;
+}
+
+#define NB_THREADS_PLAN 4
+
+static void *demande_plan(void *nbe)
+{
+  return (void*)dct_plan((long)nbe) ;
+}
+
+void dct_plan_tst()
+{
+  pthread_t threads[NB_THREADS_PLAN] ;
+  void *plans[NB_THREADS_PLAN] ;
+  float entree[BIG] = { 1 }, sortie[BIG] ;
+  int i ;
+
+  if ( dct_plan(NBE) != dct_plan(NBE) )
+    {
+      eprintf("Le plan n'est pas partagé\n") ;
+      return ;
+    }
+  if ( dct_plan(NBE) == dct_plan(NBE+1) || dct_plan(NBE+1)->nbe != NBE+1 )
+    {
+      eprintf("Deux tailles doivent avoir deux plans\n") ;
+      return ;
+    }
+
+  /* Le premier appel pour une taille, depuis plusieurs threads */
+  for(i=0; i<NB_THREADS_PLAN; i++)
+    if ( pthread_create(&threads[i], NULL, demande_plan, (void*)37L) )
+      EXIT ;
+  for(i=0; i<NB_THREADS_PLAN; i++)
+    pthread_join(threads[i], &plans[i]) ;
+  for(i=1; i<NB_THREADS_PLAN; i++)
+    if ( plans[i] != plans[0] || plans[0] != dct_plan(37) )
+      {
+	eprintf("Plusieurs plans créés pour la même taille\n") ;
+	return ;
+      }
+
+  /* "dct" utilisait la taille de son premier appel */
+  dct(0, BIG, entree, sortie) ;
+  dct(0, NBE, entree, sortie) ;
+  for(i=0; i<NBE; i++)
+    if ( fabs(sortie[i] - t[i][0]) > 0.0001 )
+      {
+	eprintf("dct de taille %d après une de taille %d fausse\n", NBE, BIG) ;
+	return ;
+      }
+}
+
+static void *demande_matrice(void *plan)
+{
+  return (void*)dct_plan_matrice(plan, 1) ;
+}
+
+/*
+ * Un plan FFT ne calcule ses matrices qu'à la première demande,
+ * une seule fois même si plusieurs threads les demandent.
+ */
+void dct_plan_matrice_tst()
+{
+  pthread_t threads[NB_THREADS_PLAN] ;
+  void *matrices[NB_THREADS_PLAN] ;
+  struct dct_plan *plan ;
+  const Matrice *d, *inv ;
+  Matrice *attendu ;
+  int i, j ;
+
+  plan = open_dct_plan(NBE) ;
+  if ( dct_plan_matrice(plan, 0) != plan->directe
+       || dct_plan_matrice(plan, 1) != plan->inverse )
+    {
+      eprintf("Sans FFT, les matrices sont celles du plan\n") ;
+      return ;
+    }
+  close_dct_plan(plan) ;
+
+  plan = open_dct_plan(DCT_FFT_MIN) ;
+  if ( plan->directe || plan->inverse )
+    {
+      eprintf("Un plan FFT ne doit pas calculer ses matrices d'avance\n") ;
+      return ;
+    }
+  for(i=0; i<NB_THREADS_PLAN; i++)
+    if ( pthread_create(&threads[i], NULL, demande_matrice, plan) )
+      EXIT ;
+  for(i=0; i<NB_THREADS_PLAN; i++)
+    pthread_join(threads[i], &matrices[i]) ;
+  d = dct_plan_matrice(plan, 0) ;
+  inv = dct_plan_matrice(plan, 1) ;
+  for(i=0; i<NB_THREADS_PLAN; i++)
+    if ( matrices[i] != inv )
+      {
+	eprintf("Matrices calculées plusieurs fois\n") ;
+	return ;
+      }
+
+  attendu = allocation_matrice_float(DCT_FFT_MIN, DCT_FFT_MIN) ;
+  coef_dct(attendu) ;
+  for(j=0; j<DCT_FFT_MIN; j++)
+    for(i=0; i<DCT_FFT_MIN; i++)
+      if ( d->t[j][i] != attendu->t[j][i] || inv->t[i][j] != d->t[j][i] )
+	{
+	  eprintf("Coefficients faux en [%d][%d]\n", j, i) ;
+	  return ;
+	}
+  liberation_matrice_float(attendu) ;
+  close_dct_plan(plan) ;
+}
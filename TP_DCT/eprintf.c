@@ -3,6 +3,8 @@
 
 static int  premiere = 1 ;
 
+long nb_allocations = 0 ;
+
 int eprintf(const char *format, ...)
 {
     va_list ap;
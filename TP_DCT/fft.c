@@ -0,0 +1,83 @@
+#include "bases.h"
+#include "fft.h"
+
+/*
+ * Les racines de l'unité et la permutation "bit reverse"
+ * sont calculées une fois pour toutes à l'ouverture.
+ */
+
+struct fft
+{
+  int n ;
+  int *permutation ;		/* Indice à l'envers en binaire */
+  float complex *racines ;	/* exp(-2 i pi k / n) pour k < n/2 */
+} ;
+
+int puissance_de_2(int n)
+{
+  return n > 0 && (n & (n - 1)) == 0 ;
+}
+
+struct fft* open_fft(int n)
+{
+  struct fft *f ;
+  int i, j, bit ;
+
+  assert(puissance_de_2(n)) ;
+  ALLOUER(f, 1) ;
+  f->n = n ;
+  ALLOUER(f->permutation, n) ;
+  ALLOUER(f->racines, MAX(n/2, 1)) ;
+
+  for(i=0, j=0; i<n; i++)
+    {
+      f->permutation[i] = j ;
+      for(bit=n>>1; bit && (j & bit); bit>>=1)
+	j ^= bit ;
+      j |= bit ;
+    }
+  for(i=0; i<n/2; i++)
+    f->racines[i] = cexp(-2 * M_PI * I * i / n) ; /* Calcul en double */
+
+  return f ;
+}
+
+void close_fft(struct fft *f)
+{
+  free(f->racines) ;
+  free(f->permutation) ;
+  free(f) ;
+}
+
+void fft(const struct fft *f, float complex *x, int inverse)
+{
+  float complex t, r ;
+  int i, j, k, taille, pas ;
+
+  for(i=0; i<f->n; i++)
+    {
+      j = f->permutation[i] ;
+      if ( i < j )
+	{
+	  t = x[i] ;
+	  x[i] = x[j] ;
+	  x[j] = t ;
+	}
+    }
+
+  /* Papillons : des blocs de taille 2 jusqu'à n */
+  for(taille=2; taille<=f->n; taille*=2)
+    {
+      pas = f->n / taille ;
+      for(i=0; i<f->n; i+=taille)
+	for(k=0; k<taille/2; k++)
+	  {
+	    r = f->racines[k*pas] ;
+	    if ( inverse )
+	      r = conjf(r) ;
+	    t = PRODUIT_COMPLEXE(r, x[i + k + taille/2]) ;
+	    x[i + k + taille/2] = x[i + k] - t ;
+	    x[i + k] += t ;
+	  }
+    }
+}
@@ -0,0 +1,33 @@
+/*
+ * Transformée de Fourier rapide (radix 2) sur des complexes flottants.
+ */
+
+#ifndef FFT_H
+#define FFT_H
+
+#include <complex.h>
+
+struct fft ;
+
+int puissance_de_2(int n) ;
+/*
+ * "n" doit être une puissance de 2.
+ */
+struct fft* open_fft(int n) ;
+void close_fft(struct fft *f) ;
+/*
+ * Transformée sur place de "x" (n complexes).
+ * L'inverse n'est pas divisée par n.
+ */
+void fft(const struct fft *f, float complex *x, int inverse) ;
+
+/*
+ * Produit complexe sans la gestion des infinis de la norme C99
+ * (qui appelle une fonction de la bibliothèque à chaque produit).
+ * Les arguments sont évalués plusieurs fois.
+ */
+#define PRODUIT_COMPLEXE(A, B)						\
+  CMPLXF(crealf(A)*crealf(B) - cimagf(A)*cimagf(B),			\
+	 crealf(A)*cimagf(B) + cimagf(A)*crealf(B))
+
+#endif
@@ -0,0 +1,97 @@
+#include "bases.h"
+#include "fft.h"
+
+/*
+ * Transformée discrète calculée naïvement (en double)
+ */
+static void dft(const float complex *x, double complex *y, int n, int inverse)
+{
+  int i, k ;
+
+  for(k=0; k<n; k++)
+    {
+      y[k] = 0 ;
+      for(i=0; i<n; i++)
+	y[k] += x[i] * cexp((inverse ? 2 : -2) * M_PI * I * i * k / n) ;
+    }
+}
+
+static int compare_dft(int n, int inverse)
+{
+  float complex x[256], y[256] ;
+  double complex attendu[256] ;
+  struct fft *f ;
+  int i ;
+
+  for(i=0; i<n; i++)
+    x[i] = y[i] = CMPLXF(i % 7 - 3, (i * i) % 5) ;
+  dft(x, attendu, n, inverse) ;
+  f = open_fft(n) ;
+  fft(f, y, inverse) ;
+  close_fft(f) ;
+  for(i=0; i<n; i++)
+    if ( cabs(y[i] - attendu[i]) > 1e-4 * n )
+      {
+	eprintf("fft(n=%d, inverse=%d)[%d] = %g%+gi au lieu de %g%+gi\n"
+		, n, inverse, i, crealf(y[i]), cimagf(y[i])
+		, creal(attendu[i]), cimag(attendu[i])) ;
+	return 0 ;
+      }
+  return 1 ;
+}
+
+void puissance_de_2_tst()
+{
+  int i ;
+  static const int oui[] = { 1, 2, 4, 8, 1024, 1<<30 } ;
+  static const int non[] = { 0, -4, 3, 6, 12, 1000 } ;
+
+  for(i=0; i<TAILLE(oui); i++)
+    if ( !puissance_de_2(oui[i]) )
+      eprintf("%d est une puissance de 2\n", oui[i]) ;
+  for(i=0; i<TAILLE(non); i++)
+    if ( puissance_de_2(non[i]) )
+      eprintf("%d n'est pas une puissance de 2\n", non[i]) ;
+}
+
+void open_fft_tst()
+{
+  int n ;
+
+  for(n=1; n<=256; n*=2)
+    if ( !compare_dft(n, 0) )
+      return ;
+}
+
+void close_fft_tst()
+{
+  struct fft *f ;
+
+  f = open_fft(16) ;
+  close_fft(f) ;
+  if ( open_fft(16) != f )
+    eprintf("Vous êtes sûr de tout libérer ?\n") ;
+}
+
+void fft_tst()
+{
+  float complex x[64], y[64] ;
+  struct fft *f ;
+  int i ;
+
+  if ( !compare_dft(64, 1) )
+    return ;
+  /* Aller-retour : l'inverse n'est pas normalisée */
+  f = open_fft(64) ;
+  for(i=0; i<64; i++)
+    x[i] = y[i] = CMPLXF(i, -i/2.) ;
+  fft(f, y, 0) ;
+  fft(f, y, 1) ;
+  close_fft(f) ;
+  for(i=0; i<64; i++)
+    if ( cabsf(y[i]/64 - x[i]) > 1e-4 )
+      {
+	eprintf("Aller-retour faux en %d\n", i) ;
+	return ;
+      }
+}
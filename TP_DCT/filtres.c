@@ -1,7 +1,9 @@
 #include <string.h>
+#include <limits.h>
 #include "bases.h"
 #include "matrice.h"
 #include "dct.h"
+#include "mdct.h"
 #include "psycho.h"
 #include "rle.h"
 #include "sf.h"
@@ -11,6 +13,8 @@
 #include "bitstream.h"
 #include "exception.h"
 #include "ondelette.h"
+#include "bench.h"
+#include "pool.h"
 
 #define LARG 8 /* 8 blocs à afficher */
 
@@ -25,6 +29,14 @@ struct parametres
   float qualite ;
   int shannon ;
   int saute_entete ;
+  int vieillissement ;
+  char *modele ;
+  int bloc ;
+  int coupure ;
+  char *masquage ;
+  int frequence ;
+  char *symboles ;
+  int jpeg ;
 } ;
 
 void fread_safe(void *ptr, size_t size, size_t nr, FILE *f)
@@ -116,26 +128,81 @@ void filtre_prediction(struct parametres *p)
 }
 
 
-void filtre_dct(struct parametres *p)
+/*
+ * Filtres travaillant trame par trame (dct, psycho, dctinv).
+ *
+ * On lit de gros paquets de trames, le pool les transforme
+ * en parallèle par tâches de TRAMES_PAR_TACHE trames
+ * puis le paquet est écrit : l'ordre des trames est conservé
+ * et la sortie est celle du traitement séquentiel.
+ * Comme avant, une trame incomplète à la fin est ignorée.
+ */
+
+#define TRAMES_PAR_TACHE 16
+#define TACHES_PAR_THREAD 4
+
+typedef void Trame(struct parametres *p, const void *entree, void *sortie) ;
+
+struct paquet
 {
-  unsigned char *buf ;
-  float *entree, *sortie ;
-  int i ;
+  struct parametres *p ;
+  Trame *f ;
+  const char *entree ;
+  char *sortie ;
+  int taille_entree, taille_sortie ;	/* Octets par trame */
+  int nb_trames ;
+} ;
 
-  ALLOUER(buf, p->nbe) ;
-  ALLOUER(entree, p->nbe) ;
-  ALLOUER(sortie, p->nbe) ;
-  while( fread((char*)buf,1,p->nbe,stdin) == p->nbe )
+static void tache_paquet(void *donnees, int tache)
+{
+  struct paquet *pq = donnees ;
+  int i, fin ;
+
+  fin = MIN((tache + 1) * TRAMES_PAR_TACHE, pq->nb_trames) ;
+  for(i=tache*TRAMES_PAR_TACHE; i<fin; i++)
+    (*pq->f)(pq->p, pq->entree + (size_t)i * pq->taille_entree
+	     , pq->sortie + (size_t)i * pq->taille_sortie) ;
+}
+
+static void filtre_trames(struct parametres *p, int taille_entree,
+			  int taille_sortie, Trame *f)
+{
+  struct paquet pq ;
+  char *entree ;
+  int nb ;
+
+  nb = pool_nb_threads() * TACHES_PAR_THREAD * TRAMES_PAR_TACHE ;
+  ALLOUER(entree, (size_t)nb * taille_entree) ;
+  ALLOUER(pq.sortie, (size_t)nb * taille_sortie) ;
+  pq.p = p ;
+  pq.f = f ;
+  pq.entree = entree ;
+  pq.taille_entree = taille_entree ;
+  pq.taille_sortie = taille_sortie ;
+  while( (pq.nb_trames = fread(entree, taille_entree, nb, stdin)) > 0 )
     {
-      for(i=0;i<p->nbe;i++)
-	entree[i] = buf[i] - 128. ;
-      dct(0, p->nbe, entree, sortie) ;
-      assert(write(1, (char*)sortie, p->nbe*sizeof(*sortie))
-	     == p->nbe*sizeof(*sortie)) ;
-    } 
-  free(buf) ;
+      pool_execute((pq.nb_trames + TRAMES_PAR_TACHE - 1) / TRAMES_PAR_TACHE,
+		   tache_paquet, &pq) ;
+      fwrite(pq.sortie, taille_sortie, pq.nb_trames, stdout) ;
+    }
   free(entree) ;
-  free(sortie) ;
+  free(pq.sortie) ;
+}
+
+static void trame_dct(struct parametres *p, const void *entree, void *sortie)
+{
+  const unsigned char *buf = entree ;
+  float son[p->nbe] ;
+  int i ;
+
+  for(i=0;i<p->nbe;i++)
+    son[i] = buf[i] - 128. ;
+  dct(0, p->nbe, son, sortie) ;
+}
+
+void filtre_dct(struct parametres *p)
+{
+  filtre_trames(p, p->nbe, p->nbe * sizeof(float), trame_dct) ;
 }
 
 void saute_entete(struct parametres *p)
@@ -149,6 +216,239 @@ void saute_entete(struct parametres *p)
     }
 }
 
+/*
+ * Le "shannon_fano" des filtres, amorcé si MODELE est défini.
+ */
+struct shannon_fano *ouvre_shannon_fano(struct parametres *p)
+{
+  struct shannon_fano *sf ;
+
+  if ( p->modele )
+    sf = open_shannon_fano_fichier(p->modele) ;
+  else
+    sf = open_shannon_fano() ;
+  sf_vieillissement(sf, p->vieillissement) ;
+  return sf ;
+}
+
+/*
+ * SYMBOLES choisit le codage de "rle", "rleinv" et "sfapprend" :
+ * "paires" (défaut) ou "jpeg" (symboles combinés et fin de bloc).
+ */
+static void lit_symboles(struct parametres *p)
+{
+  if ( p->symboles == NULL || strcmp(p->symboles, "paires") == 0 )
+    p->jpeg = 0 ;
+  else if ( strcmp(p->symboles, "jpeg") == 0 )
+    p->jpeg = 1 ;
+  else
+    {
+      fprintf(stderr, "SYMBOLES inconnu : %s\n", p->symboles) ;
+      exit(1) ;
+    }
+}
+
+/*
+ * En "jpeg", "entier_signe" n'est pas utilisé.
+ */
+static void compresse_trame(const struct parametres *p
+			    , struct intstream *entier
+			    , struct intstream *entier_signe
+			    , const float *dct)
+{
+  if ( p->jpeg )
+    compresse_jpeg(entier, p->nbe, dct) ;
+  else
+    compresse(entier, entier_signe, p->nbe, dct) ;
+}
+
+static void decompresse_trame(const struct parametres *p
+			      , struct intstream *entier
+			      , struct intstream *entier_signe
+			      , float *dct)
+{
+  if ( p->jpeg )
+    decompresse_jpeg(entier, p->nbe, dct) ;
+  else
+    decompresse(entier, entier_signe, p->nbe, dct) ;
+}
+
+/*
+ * RLE par blocs indépendants de "p->bloc" trames.
+ *
+ * Tous les blocs partent du même état shannon-fano (sf_snapshot),
+ * ils peuvent donc être codés en parallèle.
+ * Chaque bloc est précédé de son nombre de trames
+ * et de sa taille en octets.
+ */
+
+struct bloc_rle
+{
+  struct parametres *p ;
+  const struct sf_snapshot *etat ;	/* NULL si pas de shannon-fano */
+  struct shannon_fano *sf ;		/* Propre au bloc, NULL si pas de s-f */
+  float *trames ;
+  int nb_trames ;
+  char *octets ;
+  size_t nb_octets ;
+} ;
+
+static void ouvre_intstreams_bloc(struct bitstream *bs
+				  , const struct sf_snapshot *etat
+				  , struct shannon_fano *sf
+				  , struct intstream **entier
+				  , struct intstream **entier_signe)
+{
+  if ( etat )
+    {
+      sf_restore(sf, etat) ;
+      *entier = open_intstream(bs, Shannon_fano, sf) ;
+      *entier_signe = open_intstream(bs, Shannon_fano, sf) ;
+    }
+  else
+    {
+      *entier = open_intstream(bs, Entier, NULL) ;
+      *entier_signe = open_intstream(bs, Entier_Signe, NULL) ;
+    }
+}
+
+static void code_bloc_rle(void *donnees, int tache)
+{
+  struct bloc_rle *b = (struct bloc_rle*)donnees + tache ;
+  struct bitstream *bs ;
+  struct intstream *entier, *entier_signe ;
+  FILE *f ;
+  int i ;
+
+  f = open_memstream(&b->octets, &b->nb_octets) ;
+  if ( f == NULL )
+    {
+      fprintf(stderr, "Bloc RLE : open_memstream impossible\n") ;
+      exit(1) ;
+    }
+  bs = open_bitstream_file(f, "w") ;
+  ouvre_intstreams_bloc(bs, b->etat, b->sf, &entier, &entier_signe) ;
+  for(i=0; i<b->nb_trames; i++)
+    compresse_trame(b->p, entier, entier_signe, b->trames + i*b->p->nbe) ;
+  close_intstream(entier) ;
+  close_intstream(entier_signe) ;
+  close_bitstream(bs) ;
+}
+
+/*
+ * Chaque tour lit un bloc par thread du pool
+ * et les code par autant de tâches.
+ */
+static void filtre_rle_blocs(struct parametres *p, struct shannon_fano *sf)
+{
+  struct bloc_rle *blocs ;
+  struct sf_snapshot *etat ;
+  int nb, i, n, taille ;
+
+  nb = pool_nb_threads() ;
+  taille = p->nbe * sizeof(float) ;
+  etat = sf ? sf_snapshot(sf) : NULL ;
+  ALLOUER(blocs, nb) ;
+  for(i=0; i<nb; i++)
+    {
+      blocs[i].p = p ;
+      blocs[i].etat = etat ;
+      blocs[i].sf = sf ? (i == 0 ? sf : sf_clone(sf)) : NULL ;
+      ALLOUER(blocs[i].trames, p->bloc * p->nbe) ;
+    }
+
+  do
+    {
+      for(n=0; n<nb; n++)
+	{
+	  blocs[n].nb_trames = fread(blocs[n].trames, taille, p->bloc, stdin);
+	  if ( blocs[n].nb_trames == 0 )
+	    break ;
+	}
+      pool_execute(n, code_bloc_rle, blocs) ;
+
+      for(i=0; i<n; i++)
+	{
+	  int entete[2] ;
+
+	  if ( blocs[i].nb_octets > INT_MAX )
+	    {
+	      fprintf(stderr, "Bloc de %zu octets trop grand, diminuer BLOC\n"
+		      , blocs[i].nb_octets) ;
+	      exit(1) ;
+	    }
+	  entete[0] = blocs[i].nb_trames ;
+	  entete[1] = blocs[i].nb_octets ;
+	  fwrite(entete, 1, sizeof(entete), stdout) ;
+	  fwrite(blocs[i].octets, 1, blocs[i].nb_octets, stdout) ;
+	  free(blocs[i].octets) ;
+	}
+    }
+  while( n == nb && blocs[nb-1].nb_trames == p->bloc ) ;
+
+  for(i=0; i<nb; i++)
+    {
+      free(blocs[i].trames) ;
+      if ( i && blocs[i].sf )
+	close_shannon_fano(blocs[i].sf) ;
+    }
+  if ( etat )
+    sf_libere_snapshot(etat) ;
+  free(blocs) ;
+}
+
+static void filtre_rleinv_blocs(struct parametres *p, struct shannon_fano *sf)
+{
+  struct sf_snapshot *etat ;
+  struct bitstream *bs ;
+  struct intstream *entier, *entier_signe ;
+  float *sortie ;
+  char *octets ;
+  FILE *f ;
+  int entete[2] ;
+  int i ;
+
+  etat = sf ? sf_snapshot(sf) : NULL ;
+  ALLOUER(sortie, p->nbe) ;
+  while( fread(entete, 1, sizeof(entete), stdin) == sizeof(entete) )
+    {
+      /* Une trame prend au moins un bit */
+      if ( entete[0] <= 0 || entete[1] <= 0
+	   || entete[0] > 8 * (long)entete[1] )
+	{
+	  fprintf(stderr, "Entête de bloc invalide : %d trames, %d octets\n"
+		  , entete[0], entete[1]) ;
+	  exit(1) ;
+	}
+      ALLOUER(octets, entete[1]) ;
+      if ( fread(octets, 1, entete[1], stdin) != entete[1] )
+	{
+	  fprintf(stderr, "Bloc tronqué : %d octets attendus\n", entete[1]) ;
+	  exit(1) ;
+	}
+      f = fmemopen(octets, entete[1], "r") ;
+      if ( f == NULL )
+	{
+	  fprintf(stderr, "Bloc RLE : fmemopen impossible\n") ;
+	  exit(1) ;
+	}
+      bs = open_bitstream_file(f, "r") ;
+      ouvre_intstreams_bloc(bs, etat, sf, &entier, &entier_signe) ;
+      for(i=0; i<entete[0]; i++)
+	{
+	  decompresse_trame(p, entier, entier_signe, sortie) ;
+	  fwrite(sortie, p->nbe, sizeof(*sortie), stdout) ;
+	}
+      close_intstream(entier) ;
+      close_intstream(entier_signe) ;
+      close_bitstream(bs) ;
+      free(octets) ;
+    }
+  free(sortie) ;
+  if ( etat )
+    sf_libere_snapshot(etat) ;
+}
+
 void filtre_rle(struct parametres *p)
 {
   float *entree ;
@@ -156,14 +456,20 @@ void filtre_rle(struct parametres *p)
   struct bitstream *bs ;
   struct shannon_fano *sf ;
 
+  lit_symboles(p) ;
   if ( p->saute_entete )
     p->nbe *= p->nbe ;
 
   saute_entete(p) ;
+  if ( p->bloc > 0 )
+    {
+      filtre_rle_blocs(p, p->shannon ? ouvre_shannon_fano(p) : NULL) ;
+      return ;
+    }
   bs = open_bitstream("-", "w") ;
   if ( p->shannon )
     {
-      sf = open_shannon_fano() ;
+      sf = ouvre_shannon_fano(p) ;
       entier = open_intstream(bs, Shannon_fano, sf) ;
       entier_signe = open_intstream(bs, Shannon_fano, sf) ;
     }
@@ -177,14 +483,52 @@ void filtre_rle(struct parametres *p)
 
   while( fread((char*)entree,1,p->nbe*sizeof(*entree),stdin) == p->nbe*sizeof(*entree) )
     {
-      compresse(entier, entier_signe, p->nbe, entree) ;
+      compresse_trame(p, entier, entier_signe, entree) ;
     } 
+  if ( p->jpeg )
+    compresse_jpeg_fin(entier) ;
   free(entree) ;
   close_intstream(entier) ;
   close_intstream(entier_signe) ;
   close_bitstream(bs) ;
 }
 
+/*
+ * Apprentissage d'une table shannon-fano sur la même entrée que "rle".
+ * La table est écrite sur la sortie standard, elle s'utilise
+ * ensuite avec MODELE=fichier pour "rle" et "rleinv".
+ */
+void filtre_sfapprend(struct parametres *p)
+{
+  float *entree ;
+  struct intstream *entier, *entier_signe ;
+  struct shannon_fano *sf ;
+  int entete[2] ;
+
+  lit_symboles(p) ;
+  if ( p->saute_entete )
+    {
+      p->nbe *= p->nbe ;
+      fread_safe((char*)entete, 1, sizeof(entete), stdin) ;
+    }
+
+  sf = ouvre_shannon_fano(p) ;
+  entier = open_intstream(NULL, Shannon_fano_apprentissage, sf) ;
+  entier_signe = open_intstream(NULL, Shannon_fano_apprentissage, sf) ;
+
+  ALLOUER(entree, p->nbe) ;
+
+  while( fread((char*)entree,1,p->nbe*sizeof(*entree),stdin) == p->nbe*sizeof(*entree) )
+    {
+      compresse_trame(p, entier, entier_signe, entree) ;
+    } 
+  free(entree) ;
+  close_intstream(entier) ;
+  close_intstream(entier_signe) ;
+  sf_sauve(sf, "-") ;
+  close_shannon_fano(sf) ;
+}
+
 void filtre_rleinv(struct parametres *p)
 {
   float *entree ;
@@ -192,14 +536,20 @@ void filtre_rleinv(struct parametres *p)
   struct bitstream *bs ;
   struct shannon_fano *sf ;
 
+  lit_symboles(p) ;
   if ( p->saute_entete )
     p->nbe *= p->nbe ;
 
   saute_entete(p) ;
+  if ( p->bloc > 0 )
+    {
+      filtre_rleinv_blocs(p, p->shannon ? ouvre_shannon_fano(p) : NULL) ;
+      return ;
+    }
   bs = open_bitstream("-", "r") ;
   if ( p->shannon )
     {
-      sf = open_shannon_fano() ;
+      sf = ouvre_shannon_fano(p) ;
       entier = open_intstream(bs, Shannon_fano, sf) ;
       entier_signe = open_intstream(bs, Shannon_fano, sf) ;
     }
@@ -214,7 +564,7 @@ void filtre_rleinv(struct parametres *p)
   {
     for(;;)
       {
-	decompresse(entier, entier_signe, p->nbe, entree) ;
+	decompresse_trame(p, entier, entier_signe, entree) ;
 	fwrite(entree, p->nbe, sizeof(*entree), stdout) ;
       }
   }
@@ -231,18 +581,66 @@ void filtre_rleinv(struct parametres *p)
   close_bitstream(bs) ;
 }
 
-void filtre_psycho(struct parametres *p)
+static void trame_psycho(struct parametres *p, const void *entree,
+			 void *sortie)
+{
+  memcpy(sortie, entree, p->nbe * sizeof(float)) ;
+  psycho(p->nbe, sortie, p->qualite) ;
+}
+
+/* Fréquence d'échantillonnage du son, celle de "play" */
+#define FREQUENCE 4000
+
+static void trame_psycho_bark(struct parametres *p, const void *entree,
+			      void *sortie)
+{
+  memcpy(sortie, entree, p->nbe * sizeof(float)) ;
+  psycho_bark(p->nbe, sortie, p->qualite,
+	      p->frequence ? p->frequence : FREQUENCE) ;
+}
+
+/*
+ * Chaque trame dépend des précédentes : traitement séquentiel.
+ */
+static void filtre_psycho_temporel(struct parametres *p)
 {
+  struct psycho_temporel *pt ;
   float *buf ;
 
+  pt = open_psycho_temporel(p->nbe, p->frequence ? p->frequence : FREQUENCE) ;
   ALLOUER(buf, p->nbe) ;
-  while( fread((char*)buf,1,p->nbe*sizeof(*buf),stdin) == p->nbe*sizeof(*buf) )
+  while( fread(buf, sizeof(*buf), p->nbe, stdin) == p->nbe )
     {
-      psycho(p->nbe, buf, p->qualite) ;
-      assert(write(1, (char*)buf, p->nbe*sizeof(*buf))
-	     == p->nbe*sizeof(*buf));
-    } 
+      psycho_temporel(pt, buf, p->qualite) ;
+      fwrite(buf, sizeof(*buf), p->nbe, stdout) ;
+    }
   free(buf) ;
+  close_psycho_temporel(pt) ;
+}
+
+/*
+ * MASQUAGE choisit le modèle : "paires" (défaut), "bark"
+ * ou "temporel" (bark avec masquage par les trames précédentes).
+ */
+void filtre_psycho(struct parametres *p)
+{
+  Trame *f ;
+
+  if ( p->masquage && strcmp(p->masquage, "temporel") == 0 )
+    {
+      filtre_psycho_temporel(p) ;
+      return ;
+    }
+  if ( p->masquage == NULL || strcmp(p->masquage, "paires") == 0 )
+    f = trame_psycho ;
+  else if ( strcmp(p->masquage, "bark") == 0 )
+    f = trame_psycho_bark ;
+  else
+    {
+      fprintf(stderr, "MASQUAGE inconnu : %s\n", p->masquage) ;
+      exit(1) ;
+    }
+  filtre_trames(p, p->nbe * sizeof(float), p->nbe * sizeof(float), f) ;
 }
 
 void filtre_imagedct(struct parametres *p)
@@ -252,7 +650,10 @@ void filtre_imagedct(struct parametres *p)
   image = lecture_image(stdin) ;
   fwrite(&image->hauteur, 1, sizeof(image->hauteur), stdout) ;
   fwrite(&image->largeur, 1, sizeof(image->largeur), stdout) ;
-  compresse_image(p->nbe, image, stdout) ;
+  if ( p->coupure )
+    compresse_image_elaguee(p->nbe, p->qualite, p->coupure, image, stdout) ;
+  else
+    compresse_image(p->nbe, image, stdout) ;
 }
 
 void filtre_shannon_fano_8(struct parametres *p)
@@ -262,6 +663,7 @@ void filtre_shannon_fano_8(struct parametres *p)
   int c ;
 
   sf = open_shannon_fano() ;
+  sf_vieillissement(sf, p->vieillissement) ;
   bs = open_bitstream("-", "w") ;
 
   for(;;)
@@ -282,6 +684,7 @@ void filtre_shannon_fano_16(struct parametres *p)
   int c, d ;
 
   sf = open_shannon_fano() ;
+  sf_vieillissement(sf, p->vieillissement) ;
   bs = open_bitstream("-", "w") ;
 
   for(;;)
@@ -310,22 +713,83 @@ void filtre_imagedctinv(struct parametres *p)
   ecriture_image(stdout, image) ;
 }
 
+static void trame_dctinv(struct parametres *p, const void *entree,
+			 void *sortie)
+{
+  unsigned char *buf = sortie ;
+  float son[p->nbe] ;
+  int i ;
+
+  dct(1, p->nbe, entree, son) ;
+  for(i=0;i<p->nbe;i++)
+    buf[i] = son[i] + 128. ;
+}
+
 void filtre_dctinv(struct parametres *p)
+{
+  filtre_trames(p, p->nbe * sizeof(float), p->nbe, trame_dctinv) ;
+}
+
+/*
+ * Comme "dct" mais les trames se recouvrent de moitié.
+ * A la fin du son, la dernière trame est complétée par des 0
+ * puis une trame vide vide l'historique pour "mdctinv".
+ */
+void filtre_mdct(struct parametres *p)
 {
   unsigned char *buf ;
   float *entree, *sortie ;
-  int i ;
+  struct mdct *m ;
+  int i, lu ;
 
+  m = open_mdct(p->nbe) ;
   ALLOUER(buf, p->nbe) ;
   ALLOUER(entree, p->nbe) ;
   ALLOUER(sortie, p->nbe) ;
+  do
+    {
+      lu = fread((char*)buf, 1, p->nbe, stdin) ;
+      for(i=0;i<p->nbe;i++)
+	entree[i] = i < lu ? buf[i] - 128. : 0 ;
+      mdct(m, 0, entree, sortie) ;
+      assert(write(1, (char*)sortie, p->nbe*sizeof(*sortie))
+	     == p->nbe*sizeof(*sortie)) ;
+    }
+  while( lu > 0 ) ;
+  close_mdct(m) ;
+  free(buf) ;
+  free(entree) ;
+  free(sortie) ;
+}
+
+/*
+ * La première trame inverse précède le son : elle n'est pas écrite.
+ */
+void filtre_mdctinv(struct parametres *p)
+{
+  unsigned char *buf ;
+  float *entree, *sortie ;
+  struct mdct *m ;
+  int i, premiere ;
+
+  m = open_mdct(p->nbe) ;
+  ALLOUER(buf, p->nbe) ;
+  ALLOUER(entree, p->nbe) ;
+  ALLOUER(sortie, p->nbe) ;
+  premiere = 1 ;
   while( fread((char*)entree,1,p->nbe*sizeof(*entree),stdin) == p->nbe*sizeof(*entree) )
     {
-      dct(1, p->nbe, entree, sortie) ;
+      mdct(m, 1, entree, sortie) ;
+      if ( premiere )
+	{
+	  premiere = 0 ;
+	  continue ;
+	}
       for(i=0;i<p->nbe;i++)
-	buf[i] = sortie[i] + 128. ;
+	buf[i] = MAX(0, MIN(255, rint(sortie[i] + 128.))) ;
       assert(write(1, (char*)buf, p->nbe) == p->nbe) ;
     } 
+  close_mdct(m) ;
   free(buf) ;
   free(entree) ;
   free(sortie) ;
@@ -333,90 +797,75 @@ void filtre_dctinv(struct parametres *p)
 
 void filtre_quantif(struct parametres *p)
 {
-  Matrice *bloc ;
+  float *bloc ;
+  Vue v ;
   int largeur, hauteur, nb_blocs ;
-  int i ;
 
   fread_safe(&hauteur, 1, sizeof(hauteur), stdin) ;
   fread_safe(&largeur, 1, sizeof(largeur), stdin) ;
   fwrite(&hauteur, 1, sizeof(hauteur), stdout) ;
   fwrite(&largeur, 1, sizeof(largeur), stdout) ;
-  bloc = allocation_matrice_float(p->nbe, p->nbe) ;
+  ALLOUER(bloc, p->nbe * p->nbe) ;
+  v.base = bloc ;
+  v.pas = v.width = v.height = p->nbe ;
 
   nb_blocs = ((hauteur+p->nbe-1)/p->nbe) * ((largeur+p->nbe-1)/p->nbe) ;
 
   while( nb_blocs-- )
     {
-      for(i=0; i<p->nbe; i++)
-	fread_safe((char*)bloc->t[i], p->nbe, sizeof(bloc->t[0][0]), stdin) ;
-
-      quantification(p->nbe, p->qualite, bloc, p->lit_flottant) ;
-
-      for(i=0; i<p->nbe; i++)
-	fwrite((char*)bloc->t[i],p->nbe,sizeof(bloc->t[0][0]),stdout) ;
+      fread_safe((char*)bloc, p->nbe * p->nbe, sizeof(*bloc), stdin) ;
+      quantification_vue(p->nbe, p->qualite, &v, p->lit_flottant) ;
+      fwrite((char*)bloc, p->nbe * p->nbe, sizeof(*bloc), stdout) ;
     }
+  free(bloc) ;
 }
 
 void filtre_zigzag(struct parametres *p)
 {
-  Matrice *bloc ;
+  float *bloc, *parcours ;
   int largeur, hauteur, nb_blocs ;
-  int i, x, y ;
 
   fread_safe(&hauteur, 1, sizeof(hauteur), stdin) ;
   fread_safe(&largeur, 1, sizeof(largeur), stdin) ;
   fwrite(&hauteur, 1, sizeof(hauteur), stdout) ;
   fwrite(&largeur, 1, sizeof(largeur), stdout) ;
-  bloc = allocation_matrice_float(p->nbe, p->nbe) ;
+  ALLOUER(bloc, p->nbe * p->nbe) ;
+  ALLOUER(parcours, p->nbe * p->nbe) ;
 
   nb_blocs = ((hauteur+p->nbe-1)/p->nbe) * ((largeur+p->nbe-1)/p->nbe) ;
 
   while( nb_blocs-- )
     {
-      for(i=0; i<p->nbe; i++)
-	fread_safe((char*)bloc->t[i], p->nbe, sizeof(bloc->t[0][0]),stdin) ;
-
-      x = 0 ;
-      y = 0 ;
-      for(;;)
-	{
-	  fwrite((char*)&bloc->t[y][x], 1, sizeof(bloc->t[0][0]), stdout) ;
-	  if ( x==p->nbe-1 && y==p->nbe-1 )
-	    break ;
-	  zigzag(p->nbe, &y, &x) ;
-	}
+      fread_safe((char*)bloc, p->nbe * p->nbe, sizeof(*bloc), stdin) ;
+      zigzag_bloc(p->nbe, bloc, parcours, 0) ;
+      fwrite((char*)parcours, p->nbe * p->nbe, sizeof(*parcours), stdout) ;
     }
+  free(bloc) ;
+  free(parcours) ;
 }
 
 void filtre_zigzaginv(struct parametres *p)
 {
-  Matrice *bloc ;
+  float *bloc, *parcours ;
   int largeur, hauteur, nb_blocs ;
-  int i, x, y ;
 
   fread_safe(&hauteur, 1, sizeof(hauteur), stdin) ;
   fread_safe(&largeur, 1, sizeof(largeur), stdin) ;
   fwrite(&hauteur, 1, sizeof(hauteur), stdout) ;
   fwrite(&largeur, 1, sizeof(largeur), stdout) ;
-  bloc = allocation_matrice_float(p->nbe, p->nbe) ;
+  ALLOUER(bloc, p->nbe * p->nbe) ;
+  ALLOUER(parcours, p->nbe * p->nbe) ;
 
   nb_blocs = ((hauteur+p->nbe-1)/p->nbe) * ((largeur+p->nbe-1)/p->nbe) ;
 
   while( nb_blocs-- )
     {
-      x = 0 ;
-      y = 0 ;
-      for(;;)
-	{
-	  fread_safe((char*)&bloc->t[y][x], 1, sizeof(bloc->t[0][0]), stdin) ;
-	  if ( x==p->nbe-1 && y==p->nbe-1 )
-	    break ;
-	  zigzag(p->nbe, &y, &x) ;
-	}
-
-      for(i=0; i<p->nbe; i++)
-	fwrite((char*)bloc->t[i],p->nbe,sizeof(bloc->t[0][0]),stdout) ;
+      fread_safe((char*)parcours, p->nbe * p->nbe, sizeof(*parcours), stdin) ;
+      zigzag_bloc(p->nbe, parcours, bloc, 1) ;
+      fwrite((char*)bloc, p->nbe * p->nbe, sizeof(*bloc), stdout) ;
     }
+  free(bloc) ;
+  free(parcours) ;
 }
 
 void filtre_ondelette(struct parametres *p)
@@ -429,6 +878,11 @@ void filtre_ondeletteinv(struct parametres *p)
    ondelette_decode_image() ;
 }
 
+void filtre_bench(struct parametres *p)
+{
+  bench(getenv("BENCH")) ;
+}
+
 #define ARG(X) { #X, (char*)&pp.X - (char*)&pp }
 
 void filtres(int argc, char **argv)
@@ -439,9 +893,12 @@ void filtres(int argc, char **argv)
     { "affiche_dct" , affiche_son            , 1, 128, 33, 10 , 0},
     { "dct"         ,  filtre_dct            , 0, 128, 33, 10 , 0},
     { "dctinv"      ,  filtre_dctinv         , 0, 128, 33, 10 , 0},
+    { "mdct"        ,  filtre_mdct           , 0, 128, 33, 10 , 0},
+    { "mdctinv"     ,  filtre_mdctinv        , 0, 128, 33, 10 , 0},
     { "psycho"      ,  filtre_psycho         , 0, 128, 33, 0.5, 0},
     { "rle"         ,  filtre_rle            , 0, 128, 33, 10 , 0},
     { "rleinv"      ,  filtre_rleinv         , 0, 128, 33, 10 , 0},
+    { "sfapprend"   ,  filtre_sfapprend      , 0, 128, 33, 10 , 0},
     { "imagedct"    ,  filtre_imagedct       , 0,   8, 33, 10 , 0},
     { "imagedctinv" ,  filtre_imagedctinv    , 0,   8, 33, 10 , 0},
     { "quantif"     ,  filtre_quantif        , 0,   8, 33, 10 , 0},
@@ -455,6 +912,7 @@ void filtres(int argc, char **argv)
     { "prediction"  ,  filtre_prediction     , 0, 128, 33, 10 , 0},
     { "prediction2" ,  filtre_prediction     , 0, 128, 33, 10 , 1},
     { "prediction3" ,  filtre_prediction     , 0, 128, 33, 10 , 2},
+    { "bench"       ,  filtre_bench          , 0, 128, 33, 10 , 0},
   } ;
 
   struct parametres pp ;
@@ -486,6 +944,27 @@ void filtres(int argc, char **argv)
 	if ( getenv("SAUTE_ENTETE") )
 	  pp.saute_entete = atof(getenv("SAUTE_ENTETE")) ;
 
+	if ( getenv("VIEILLISSEMENT") )
+	  pp.vieillissement = atoi(getenv("VIEILLISSEMENT")) ;
+
+	if ( getenv("MODELE") )
+	  pp.modele = getenv("MODELE") ;
+
+	if ( getenv("BLOC") )
+	  pp.bloc = atoi(getenv("BLOC")) ;
+
+	if ( getenv("COUPURE") )
+	  pp.coupure = atoi(getenv("COUPURE")) ;
+
+	if ( getenv("MASQUAGE") )
+	  pp.masquage = getenv("MASQUAGE") ;
+
+	if ( getenv("FREQUENCE") )
+	  pp.frequence = atoi(getenv("FREQUENCE")) ;
+
+	if ( getenv("SYMBOLES") )
+	  pp.symboles = getenv("SYMBOLES") ;
+
 	(*p[i].fct)(&pp) ;
 	exit(0) ;
       }
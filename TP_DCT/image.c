@@ -27,9 +27,11 @@ struct image* allocation_image(int hauteur, int largeur) {
 
     im->hauteur = hauteur;
     im->largeur = largeur;
+    im->pas = PAS_ALIGNE(largeur, 1);
     ALLOUER(im->pixels, hauteur);
+    ALLOUER_ALIGNE(im->donnees, hauteur * im->pas);
     for(int i = 0; i<hauteur; ++i) {
-        ALLOUER(im->pixels[i], largeur);
+        im->pixels[i] = IMAGE_LIGNE(im, i);
     }
 
     return im;
@@ -40,8 +42,7 @@ struct image* allocation_image(int hauteur, int largeur) {
  */
 
 void liberation_image(struct image* image) {
-    for (int i = 0; i < image->hauteur; i++)
-        free(image->pixels[i]);
+    free(image->donnees);
     free(image->pixels);
     free(image);
 }
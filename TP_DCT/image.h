@@ -12,8 +12,15 @@ struct image
   int largeur ;
   int hauteur ;
   unsigned char **pixels ;
+  unsigned char *donnees ;	/* Bloc unique aligné contenant les lignes */
+  int pas ;			/* Nombre d'octets entre deux lignes */
 } ;
 
+/*
+ * Comme pour les matrices, "pixels[j]" pointe dans "donnees".
+ */
+#define IMAGE_LIGNE(I,J) ( (I)->donnees + (J)*(I)->pas )
+
 #define MAXLIGNE 9999 /* Longueur maximale d'une ligne de commentaire */
 
 void lire_ligne(FILE *f, char *ligne) ;
@@ -52,6 +52,14 @@ void allocation_image_tst()
   image = allocation_image(1000, 1) ;
   for(i=0; i<1000; i++)
     image->pixels[i][0] = 99 ;
+
+  for(i=0; i<1000; i++)
+    if ( image->pixels[i] != IMAGE_LIGNE(image, i)
+	 || (size_t)image->pixels[i] % ALIGNEMENT )
+      {
+	eprintf("La ligne %d n'est pas alignée dans le bloc de pixels\n", i) ;
+	return ;
+      }
 }
 
 
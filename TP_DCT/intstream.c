@@ -1,6 +1,7 @@
 #include "intstream.h"
 #include "sf.h"
 #include "entier.h"
+#include "bits.h"
 
 struct intstream
 {
@@ -20,7 +21,7 @@ struct intstream* open_intstream(struct bitstream *bitstream
   is->bitstream = bitstream ;
   is->type = type ;
 
-  if ( type == Shannon_fano )
+  if ( type == Shannon_fano || type == Shannon_fano_apprentissage )
     {
       if ( shannon_fano == NULL )
 	EXIT ;
@@ -42,6 +43,9 @@ void put_entier_intstream(struct intstream *is, int evenement)
     case Shannon_fano:
       put_entier_shannon_fano(is->bitstream, is->shannon_fano, evenement) ;
       break ;
+    case Shannon_fano_apprentissage:
+      sf_apprend(is->shannon_fano, evenement) ;
+      break ;
     case Entier:
       put_entier(is->bitstream, evenement) ;
       break ;
@@ -67,3 +71,33 @@ int get_entier_intstream(struct intstream *is)
       EXIT ;
     }
 }
+
+void put_paires_intstream(struct intstream *ia, struct intstream *ib
+			  , const int *a, const int *b, int nb)
+{
+  int i ;
+
+  if ( ia->type == Entier && ib->type == Entier_Signe )
+    for(i=0; i<nb; i++)
+      {
+	put_entier(ia->bitstream, a[i]) ;
+	put_entier_signe(ib->bitstream, b[i]) ;
+      }
+  else
+    for(i=0; i<nb; i++)
+      {
+	put_entier_intstream(ia, a[i]) ;
+	put_entier_intstream(ib, b[i]) ;
+      }
+}
+
+void put_bits_intstream(struct intstream *is, int nb, unsigned v)
+{
+  if ( is->type != Shannon_fano_apprentissage )
+    put_bits(is->bitstream, nb, v) ;
+}
+
+unsigned get_bits_intstream(struct intstream *is, int nb)
+{
+  return get_bits(is->bitstream, nb) ;
+}
@@ -20,6 +20,7 @@ enum intstream_type
 {  Entier
   ,Entier_Signe
   ,Shannon_fano
+  ,Shannon_fano_apprentissage	/* N'écrit rien, la table apprend */
 } ;
 
 /*
@@ -35,5 +36,18 @@ struct intstream* open_intstream(struct bitstream *bitstream
 void        close_intstream(struct intstream *is) ;
 void   put_entier_intstream(struct intstream *is, int evenement) ;
 int    get_entier_intstream(struct intstream *is) ;
+/*
+ * Ecrit "nb" paires dans l'ordre : a[0] dans "ia", b[0] dans "ib",
+ * a[1] dans "ia"... Comme autant d'appels à "put_entier_intstream",
+ * mais la méthode de codage n'est choisie qu'une fois.
+ */
+void   put_paires_intstream(struct intstream *ia, struct intstream *ib
+			    , const int *a, const int *b, int nb) ;
+/*
+ * "nb" bits bruts (sans codage) dans le "bitstream" de l'intstream.
+ * En apprentissage rien n'est écrit.
+ */
+void   put_bits_intstream(struct intstream *is, int nb, unsigned v) ;
+unsigned get_bits_intstream(struct intstream *is, int nb) ;
 
 #endif
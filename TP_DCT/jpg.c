@@ -3,6 +3,9 @@
 #include "dct.h"
 #include "jpg.h"
 #include "image.h"
+#include "arene.h"
+#include "simd.h"
+#include "tables.h"
 
 /*
  * Calcul de la DCT ou de l'inverse DCT sur un petit carré de l'image.
@@ -11,29 +14,1029 @@
  *
  * DCT de l'image :  DCT * IMAGE * DCT transposée
  * Inverse        :  DCT transposée * I' * DCT
+ *
+ * Les coefficients viennent du plan partagé de taille "nbe",
+ * la matrice de travail est empruntée à l'arène du thread :
+ * après le premier bloc, il n'y a plus ni calcul de cosinus
+ * ni allocation.
+ *
+ * "bloc" est une vue nbe x nbe, par exemple dans l'image entière.
  */
+void dct_vue(int inverse, int nbe, Vue *bloc) {
+    const struct dct_plan *plan = dct_plan(nbe);
+    struct arene *arene = arene_session();
+    Matrice* tmp = arene_matrice(arene, nbe, nbe);
+    Vue vd, vt, vtmp;
+
+    assert(bloc->height == nbe && bloc->width == nbe);
+    vd = vue_matrice(dct_plan_matrice(plan, inverse), 0, 0, nbe, nbe);
+    vt = vue_matrice(dct_plan_matrice(plan, !inverse), 0, 0, nbe, nbe);
+    vtmp = vue_matrice(tmp, 0, 0, nbe, nbe);
+    produit_vues(&vd, bloc, &vtmp);
+    produit_vues(&vtmp, &vt, bloc);
+
+    arene_rend(arene, tmp);
+}
+
 void dct_image(int inverse, int nbe, Matrice *image) {
-    Matrice* dct = allocation_matrice_float(nbe, nbe);
-    Matrice* dct_t;
-    coef_dct(dct);
-
-    if(inverse) {
-        dct_t = dct;
-        dct = allocation_matrice_float(nbe, nbe);
-	    transposition_matrice(dct_t, dct);
-    } 
+    struct arene *arene = arene_session();
+    Matrice *copie;
+    Vue v = arene_vue(arene, image, &copie);
+
+    dct_vue(inverse, nbe, &v);
+    arene_rend_vue(arene, copie, image);
+}
+
+/*
+ *****************************************************************************
+ * DCT d'une bande de blocs.
+ *
+ * Pour les petits blocs, le coût des appels et des pointeurs de lignes
+ * dépasse celui des calculs. On traite donc LOT blocs ensemble :
+ * ils sont entrelacés (l'élément (y,x) des LOT blocs est contigu),
+ * chaque voie d'un registre SIMD calcule un bloc différent
+ * et tous les calculs se font avec des registres pleins.
+ * Les coefficients sont ceux du plan, calculés une seule fois :
+ * pour chaque bloc il ne reste que les multiplications-additions
+ * et l'entrelacement (une transposition).
+ *
+ * L'ordre des opérations est celui de "produit_matrices_float"
+ * (somme de 0 vers nbe, multiplication puis addition).
+ * Pour nbe=8 on utilise la DCT rapide AAN (plus bas).
+ *****************************************************************************
+ */
+
+#define LOT 8
+
+/*
+ * DCT d'un bloc = DCT 1D des colonnes puis DCT 1D des lignes,
+ * avec la même matrice M (directe ou inverse du plan) :
+ *
+ *   tmp(u,v) = somme sur k de M(u,k) x(k,v)     colonnes
+ *   x(u,v)   = somme sur k de M(v,k) tmp(u,k)   lignes
+ *
+ * Une passe calcule s(l,i) = somme sur k de M(i,k) e(l,k) ou
+ * l'élément (l,k) est la ligne "l*pas_l + k*pas_k" des LOT blocs
+ * entrelacés. Chaque ligne "l" produit GROUPE sorties à la fois
+ * pour que les sommes soient indépendantes : on est limité par
+ * le nombre de multiplications et non par la latence des additions.
+ * Chaque somme se fait de k=0 à nk-1 (nbe sauf pour les entrées creuses).
+ * Seules les lignes l < nl sont calculées et, pour la ligne l,
+ * les sorties i < ni[l] : c'est ce qui permet la DCT élaguée.
+ *
+ * M(i,k) vaut c[i*ci + k*ck] : la matrice du plan ou, pour nbe=16
+ * et nbe=32, une table constante générée par "tables_genere"
+ * (l'inverse est la transposée : ci et ck sont échangés).
+ * Pour ces tailles les corps des passes sont recompilés
+ * avec "nbe" constant : les boucles sont déroulées.
+ */
+
+#define GROUPE 8
+
+typedef void Passe_lot(int nbe, const float *c, int ci, int ck,
+		       const Matrice *e, Matrice *s, int pas_l, int pas_k,
+		       int nl, const int *ni, int nk) ;
+
+/*
+ * Les corps sont toujours intégrés à l'appelant
+ * pour être compilés avec ses constantes.
+ */
+#define CORPS static inline __attribute__((always_inline))
+
+CORPS void corps_scalaire(int nbe, const float *c, int ci, int ck,
+			  const Matrice *e, Matrice *s, int pas_l, int pas_k,
+			  int nl, const int *ni, int nk)
+{
+  int l, i, k, b ;
+  float r[LOT], m ;
+  const float *x ;
+
+  for(l=0; l<nl; l++)
+    for(i=0; i<ni[l]; i++)
+      {
+	for(b=0; b<LOT; b++)
+	  r[b] = 0 ;
+	for(k=0; k<nk; k++)
+	  {
+	    m = c[i*ci + k*ck] ;
+	    x = e->t[l*pas_l + k*pas_k] ;
+	    for(b=0; b<LOT; b++)
+	      r[b] += m * x[b] ;
+	  }
+	for(b=0; b<LOT; b++)
+	  s->t[l*pas_l + i*pas_k][b] = r[b] ;
+      }
+}
+
+#ifdef SIMD_X86
+
+/*
+ * Les "taille" lignes de M utilisées pour les sorties i à i+taille-1.
+ * Au delà de nbe on refait la dernière (le résultat n'est pas stocké) :
+ * les boucles sur le groupe ont une longueur fixe et les sommes
+ * restent dans les registres.
+ */
+CORPS void lignes_groupe(int nbe, const float *c, int ci, int i, int taille,
+			 const float **lignes)
+{
+  int g ;
+
+  for(g=0; g<taille; g++)
+    lignes[g] = c + MIN(i + g, nbe - 1) * ci ;
+}
+
+/*
+ * Deux registres par lot : des groupes deux fois plus petits
+ * pour que les sommes tiennent dans les 16 registres.
+ */
+CORPS void corps_sse(int nbe, const float *c, int ci, int ck,
+		     const Matrice *e, Matrice *s, int pas_l, int pas_k,
+		     int nl, const int *ni, int nk)
+{
+  __m128 s0[GROUPE/2], s1[GROUPE/2], x0, x1, m ;
+  const float *lignes[GROUPE/2] ;
+  int l, i, k, g, n ;
+
+  for(l=0; l<nl; l++)
+    for(i=0; i<ni[l]; i+=n)
+      {
+	n = MIN(GROUPE/2, ni[l] - i) ;
+	lignes_groupe(nbe, c, ci, i, GROUPE/2, lignes) ;
+	for(g=0; g<GROUPE/2; g++)
+	  s0[g] = s1[g] = _mm_setzero_ps() ;
+	for(k=0; k<nk; k++)
+	  {
+	    x0 = _mm_load_ps(e->t[l*pas_l + k*pas_k]) ;
+	    x1 = _mm_load_ps(e->t[l*pas_l + k*pas_k] + 4) ;
+	    for(g=0; g<GROUPE/2; g++)
+	      {
+		m = _mm_set1_ps(lignes[g][k*ck]) ;
+		s0[g] = _mm_add_ps(s0[g], _mm_mul_ps(m, x0)) ;
+		s1[g] = _mm_add_ps(s1[g], _mm_mul_ps(m, x1)) ;
+	      }
+	  }
+	for(g=0; g<n; g++)
+	  {
+	    _mm_store_ps(s->t[l*pas_l + (i+g)*pas_k], s0[g]) ;
+	    _mm_store_ps(s->t[l*pas_l + (i+g)*pas_k] + 4, s1[g]) ;
+	  }
+      }
+}
+
+CIBLE_AVX CORPS
+void corps_avx(int nbe, const float *c, int ci, int ck,
+	       const Matrice *e, Matrice *s, int pas_l, int pas_k,
+	       int nl, const int *ni, int nk)
+{
+  __m256 r[GROUPE], x ;
+  const float *lignes[GROUPE] ;
+  int l, i, k, g, n ;
+
+  for(l=0; l<nl; l++)
+    for(i=0; i<ni[l]; i+=n)
+      {
+	n = MIN(GROUPE, ni[l] - i) ;
+	lignes_groupe(nbe, c, ci, i, GROUPE, lignes) ;
+	for(g=0; g<GROUPE; g++)
+	  r[g] = _mm256_setzero_ps() ;
+	for(k=0; k<nk; k++)
+	  {
+	    x = _mm256_load_ps(e->t[l*pas_l + k*pas_k]) ;
+	    for(g=0; g<GROUPE; g++)
+	      r[g] = _mm256_add_ps(r[g],
+				   _mm256_mul_ps(_mm256_set1_ps(lignes[g][k*ck]),
+						 x)) ;
+	  }
+	for(g=0; g<n; g++)
+	  _mm256_store_ps(s->t[l*pas_l + (i+g)*pas_k], r[g]) ;
+      }
+}
+
+#endif
+
+/*
+ * Une passe par niveau SIMD, générique (N=nbe) ou spécialisée
+ */
+#define PASSE(CIBLE, NIVEAU, NOM, N, K)					\
+  CIBLE static void NOM(int nbe, const float *c, int ci, int ck,	\
+			const Matrice *e, Matrice *s, int pas_l, int pas_k, \
+			int nl, const int *ni, int nk)			\
+  {									\
+    corps_##NIVEAU(N, c, ci, ck, e, s, pas_l, pas_k, nl, ni, K) ;	\
+  }
+
+#ifdef SIMD_X86
+#define PASSES(N, K, SUFFIXE)						\
+  PASSE(, scalaire, passe_scalaire##SUFFIXE, N, K)			\
+  PASSE(, sse, passe_sse##SUFFIXE, N, K)				\
+  PASSE(CIBLE_AVX, avx, passe_avx##SUFFIXE, N, K)
+#else
+#define PASSES(N, K, SUFFIXE)						\
+  PASSE(, scalaire, passe_scalaire##SUFFIXE, N, K)
+#endif
+
+PASSES(nbe, nbe, )
+PASSES(16, 16, _16)
+PASSES(32, 32, _32)
+PASSES(nbe, nk, _creuse)
+PASSES(16, nk, _creuse_16)
+PASSES(32, nk, _creuse_32)
+
+/*
+ * Si "creuse" est vrai, la passe ne fait que les sommes
+ * de k=0 à nk-1 (les éléments suivants sont nuls).
+ */
+static Passe_lot *choix_passe(int nbe, int creuse)
+{
+  static Passe_lot *passes[][3][3] =
+    {
+#ifdef SIMD_X86
+      {
+	{ passe_scalaire, passe_sse, passe_avx },
+	{ passe_scalaire_16, passe_sse_16, passe_avx_16 },
+	{ passe_scalaire_32, passe_sse_32, passe_avx_32 },
+      },
+      {
+	{ passe_scalaire_creuse, passe_sse_creuse, passe_avx_creuse },
+	{ passe_scalaire_creuse_16, passe_sse_creuse_16, passe_avx_creuse_16 },
+	{ passe_scalaire_creuse_32, passe_sse_creuse_32, passe_avx_creuse_32 },
+      },
+#else
+      {
+	{ passe_scalaire, passe_scalaire, passe_scalaire },
+	{ passe_scalaire_16, passe_scalaire_16, passe_scalaire_16 },
+	{ passe_scalaire_32, passe_scalaire_32, passe_scalaire_32 },
+      },
+      {
+	{ passe_scalaire_creuse, passe_scalaire_creuse, passe_scalaire_creuse },
+	{ passe_scalaire_creuse_16, passe_scalaire_creuse_16,
+	  passe_scalaire_creuse_16 },
+	{ passe_scalaire_creuse_32, passe_scalaire_creuse_32,
+	  passe_scalaire_creuse_32 },
+      },
+#endif
+    } ;
+
+  return passes[creuse][nbe == 16 ? 1 : nbe == 32 ? 2 : 0][simd_niveau()] ;
+}
+
+/*
+ * La table constante des coefficients, NULL si "nbe"
+ * n'est pas une taille spécialisée.
+ */
+static const float *coefficients_constants(int nbe)
+{
+  switch(nbe)
+    {
+    case 16: return dct_16 ;
+    case 32: return dct_32 ;
+    default: return NULL ;
+    }
+}
+
+/*
+ *****************************************************************************
+ * DCT 8x8 rapide d'Arai, Agui et Nakajima (AAN).
+ *
+ * La DCT 1D de 8 valeurs se fait en 29 additions et 5 multiplications
+ * mais le résultat k est multiplié par sqrt(8) a(k) avec
+ * a(0) = 1 et a(k) = sqrt(2) cos(k pi / 16).
+ * En 2D le coefficient (u,v) doit donc être multiplié par
+ * 1 / (8 a(u) a(v)) : cette mise à l'échelle est une table de 64
+ * multiplicateurs dans laquelle on peut aussi mettre la quantification.
+ * L'inverse multiplie ses entrées par a(u) a(v) / 8.
+ *
+ * Les papillons sont écrits une seule fois avec les opérations
+ * ADD, SUB et MUL (par une constante) : ils s'appliquent à des
+ * flottants ou à des registres SIMD contenant LOT blocs.
+ *****************************************************************************
+ */
+
+#define AAN_DIRECTE(T, ADD, SUB, MUL, x)				\
+  do {									\
+    T t0 = ADD(x[0], x[7]), t7 = SUB(x[0], x[7]) ;			\
+    T t1 = ADD(x[1], x[6]), t6 = SUB(x[1], x[6]) ;			\
+    T t2 = ADD(x[2], x[5]), t5 = SUB(x[2], x[5]) ;			\
+    T t3 = ADD(x[3], x[4]), t4 = SUB(x[3], x[4]) ;			\
+    T t10 = ADD(t0, t3), t13 = SUB(t0, t3) ;				\
+    T t11 = ADD(t1, t2), t12 = SUB(t1, t2) ;				\
+    T z1, z2, z3, z4, z5, z11, z13 ;					\
+    x[0] = ADD(t10, t11) ;						\
+    x[4] = SUB(t10, t11) ;						\
+    z1 = MUL(ADD(t12, t13), 0.707106781f) ;				\
+    x[2] = ADD(t13, z1) ;						\
+    x[6] = SUB(t13, z1) ;						\
+    /* Partie impaire */						\
+    t10 = ADD(t4, t5) ;							\
+    t11 = ADD(t5, t6) ;							\
+    t12 = ADD(t6, t7) ;							\
+    z5 = MUL(SUB(t10, t12), 0.382683433f) ;				\
+    z2 = ADD(MUL(t10, 0.541196100f), z5) ;				\
+    z4 = ADD(MUL(t12, 1.306562965f), z5) ;				\
+    z3 = MUL(t11, 0.707106781f) ;					\
+    z11 = ADD(t7, z3) ;							\
+    z13 = SUB(t7, z3) ;							\
+    x[5] = ADD(z13, z2) ;						\
+    x[3] = SUB(z13, z2) ;						\
+    x[1] = ADD(z11, z4) ;						\
+    x[7] = SUB(z11, z4) ;						\
+  } while(0)
+
+#define AAN_INVERSE(T, ADD, SUB, MUL, x)				\
+  do {									\
+    T t10 = ADD(x[0], x[4]), t11 = SUB(x[0], x[4]) ;			\
+    T t13 = ADD(x[2], x[6]) ;						\
+    T t12 = SUB(MUL(SUB(x[2], x[6]), 1.414213562f), t13) ;		\
+    T t0 = ADD(t10, t13), t3 = SUB(t10, t13) ;				\
+    T t1 = ADD(t11, t12), t2 = SUB(t11, t12) ;				\
+    T z13 = ADD(x[5], x[3]), z10 = SUB(x[5], x[3]) ;			\
+    T z11 = ADD(x[1], x[7]), z12 = SUB(x[1], x[7]) ;			\
+    T z5 = MUL(ADD(z10, z12), 1.847759065f) ;				\
+    T t4, t5, t6, t7 ;							\
+    t7 = ADD(z11, z13) ;						\
+    t11 = MUL(SUB(z11, z13), 1.414213562f) ;				\
+    t10 = SUB(MUL(z12, 1.082392200f), z5) ;				\
+    t12 = ADD(MUL(z10, -2.613125930f), z5) ;				\
+    t6 = SUB(t12, t7) ;							\
+    t5 = SUB(t11, t6) ;							\
+    t4 = ADD(t10, t5) ;							\
+    x[0] = ADD(t0, t7) ;						\
+    x[7] = SUB(t0, t7) ;						\
+    x[1] = ADD(t1, t6) ;						\
+    x[6] = SUB(t1, t6) ;						\
+    x[2] = ADD(t2, t5) ;						\
+    x[5] = SUB(t2, t5) ;						\
+    x[4] = ADD(t3, t4) ;						\
+    x[3] = SUB(t3, t4) ;						\
+  } while(0)
+
+/*
+ * Le coefficient continu seul, avec les additions de AAN_DIRECTE
+ * dans le même ordre : le résultat est le même au bit près.
+ */
+#define AAN_CONTINU(ADD, x)						\
+  ADD(ADD(ADD(x[0], x[7]), ADD(x[3], x[4])),				\
+      ADD(ADD(x[1], x[6]), ADD(x[2], x[5])))
+
+/*
+ * Les LOT blocs entrelacés de "x" (ligne y*8+i : l'élément (y,i))
+ * sont transformés sur place. "echelle" est appliquée à la sortie
+ * de la DCT et à l'entrée de l'inverse.
+ * Seules les "colonnes" premières colonnes sont transformées
+ * par la première passe : les autres doivent être nulles.
+ *
+ * Pour la DCT directe, "longueurs" (8 valeurs, voir "dct_masque")
+ * ne garde que les longueurs[u] premiers coefficients de la ligne u,
+ * les autres sont mis à 0 :
+ *   - une ligne vide n'est pas transformée ;
+ *   - une ligne (ou une passe des colonnes) dont on ne garde que
+ *     le premier coefficient ne fait que la somme ;
+ *   - les lignes au delà de la dernière non vide ne sont pas
+ *     calculées par la passe des colonnes.
+ */
+typedef void Noyau_aan(int inverse, Matrice *x, const float *echelle,
+		       int colonnes, const int *longueurs) ;
+
+/*
+ * Nombre de lignes utiles de la passe des colonnes
+ */
+static int lignes_aan(const int *longueurs)
+{
+  int nu = 8 ;
+
+  while( nu > 0 && longueurs[nu-1] == 0 )
+    nu-- ;
+  return nu ;
+}
+
+#define ADD_S(A, B) ((A) + (B))
+#define SUB_S(A, B) ((A) - (B))
+#define MUL_S(A, C) ((A) * (C))
+
+static void aan_scalaire(int inverse, Matrice *x, const float *echelle,
+			 int colonnes, const int *longueurs)
+{
+  float v[8] ;
+  int i, k, b, l, nu ;
+
+  nu = lignes_aan(longueurs) ;
+  for(b=0; b<LOT; b++)
+    {
+      if ( inverse )
+	for(i=0; i<64; i++)
+	  x->t[i][b] *= echelle[i] ;
+      for(i=0; i<colonnes; i++)	/* Colonnes */
+	{
+	  for(k=0; k<8; k++)
+	    v[k] = x->t[k*8 + i][b] ;
+	  if ( inverse )
+	    AAN_INVERSE(float, ADD_S, SUB_S, MUL_S, v) ;
+	  else if ( nu <= 1 )
+	    v[0] = AAN_CONTINU(ADD_S, v) ;
+	  else
+	    AAN_DIRECTE(float, ADD_S, SUB_S, MUL_S, v) ;
+	  for(k=0; k<(inverse ? 8 : nu); k++)
+	    x->t[k*8 + i][b] = v[k] ;
+	}
+      for(i=0; i<8; i++)	/* Lignes */
+	{
+	  l = longueurs[i] ;
+	  if ( l )
+	    {
+	      for(k=0; k<8; k++)
+		v[k] = x->t[i*8 + k][b] ;
+	      if ( inverse )
+		AAN_INVERSE(float, ADD_S, SUB_S, MUL_S, v) ;
+	      else if ( l == 1 )
+		v[0] = AAN_CONTINU(ADD_S, v) ;
+	      else
+		AAN_DIRECTE(float, ADD_S, SUB_S, MUL_S, v) ;
+	    }
+	  for(k=0; k<8; k++)
+	    x->t[i*8 + k][b] = inverse ? v[k] : k < l ? v[k] * echelle[i*8 + k]
+	      : 0 ;
+	}
+    }
+}
+
+#ifdef SIMD_X86
+
+#define MUL_SSE(A, C) _mm_mul_ps(A, _mm_set1_ps(C))
+
+/*
+ * Un lot fait deux registres : on traite chaque moitié
+ * comme un lot de 4 blocs.
+ */
+static void aan_sse(int inverse, Matrice *x, const float *echelle,
+		    int colonnes, const int *longueurs)
+{
+  __m128 v[8] ;
+  int i, k, h, l, nu ;
+
+  nu = lignes_aan(longueurs) ;
+  for(h=0; h<LOT; h+=4)
+    {
+      if ( inverse )
+	for(i=0; i<64; i++)
+	  _mm_store_ps(x->t[i] + h, MUL_SSE(_mm_load_ps(x->t[i] + h),
+					    echelle[i])) ;
+      for(i=0; i<colonnes; i++)
+	{
+	  for(k=0; k<8; k++)
+	    v[k] = _mm_load_ps(x->t[k*8 + i] + h) ;
+	  if ( inverse )
+	    AAN_INVERSE(__m128, _mm_add_ps, _mm_sub_ps, MUL_SSE, v) ;
+	  else if ( nu <= 1 )
+	    v[0] = AAN_CONTINU(_mm_add_ps, v) ;
+	  else
+	    AAN_DIRECTE(__m128, _mm_add_ps, _mm_sub_ps, MUL_SSE, v) ;
+	  for(k=0; k<(inverse ? 8 : nu); k++)
+	    _mm_store_ps(x->t[k*8 + i] + h, v[k]) ;
+	}
+      for(i=0; i<8; i++)
+	{
+	  l = longueurs[i] ;
+	  if ( l )
+	    {
+	      for(k=0; k<8; k++)
+		v[k] = _mm_load_ps(x->t[i*8 + k] + h) ;
+	      if ( inverse )
+		AAN_INVERSE(__m128, _mm_add_ps, _mm_sub_ps, MUL_SSE, v) ;
+	      else if ( l == 1 )
+		v[0] = AAN_CONTINU(_mm_add_ps, v) ;
+	      else
+		AAN_DIRECTE(__m128, _mm_add_ps, _mm_sub_ps, MUL_SSE, v) ;
+	    }
+	  if ( !inverse )
+	    for(k=0; k<8; k++)
+	      v[k] = k < l ? MUL_SSE(v[k], echelle[i*8 + k]) : _mm_setzero_ps() ;
+	  for(k=0; k<8; k++)
+	    _mm_store_ps(x->t[i*8 + k] + h, v[k]) ;
+	}
+    }
+}
+
+#define MUL_AVX(A, C) _mm256_mul_ps(A, _mm256_set1_ps(C))
+
+CIBLE_AVX
+static void aan_avx(int inverse, Matrice *x, const float *echelle,
+		    int colonnes, const int *longueurs)
+{
+  __m256 v[8] ;
+  int i, k, l, nu ;
+
+  nu = lignes_aan(longueurs) ;
+  if ( inverse )
+    for(i=0; i<64; i++)
+      _mm256_store_ps(x->t[i], MUL_AVX(_mm256_load_ps(x->t[i]), echelle[i])) ;
+  for(i=0; i<colonnes; i++)
+    {
+      for(k=0; k<8; k++)
+	v[k] = _mm256_load_ps(x->t[k*8 + i]) ;
+      if ( inverse )
+	AAN_INVERSE(__m256, _mm256_add_ps, _mm256_sub_ps, MUL_AVX, v) ;
+      else if ( nu <= 1 )
+	v[0] = AAN_CONTINU(_mm256_add_ps, v) ;
+      else
+	AAN_DIRECTE(__m256, _mm256_add_ps, _mm256_sub_ps, MUL_AVX, v) ;
+      for(k=0; k<(inverse ? 8 : nu); k++)
+	_mm256_store_ps(x->t[k*8 + i], v[k]) ;
+    }
+  for(i=0; i<8; i++)
+    {
+      l = longueurs[i] ;
+      if ( l )
+	{
+	  for(k=0; k<8; k++)
+	    v[k] = _mm256_load_ps(x->t[i*8 + k]) ;
+	  if ( inverse )
+	    AAN_INVERSE(__m256, _mm256_add_ps, _mm256_sub_ps, MUL_AVX, v) ;
+	  else if ( l == 1 )
+	    v[0] = AAN_CONTINU(_mm256_add_ps, v) ;
+	  else
+	    AAN_DIRECTE(__m256, _mm256_add_ps, _mm256_sub_ps, MUL_AVX, v) ;
+	}
+      if ( !inverse )
+	for(k=0; k<8; k++)
+	  v[k] = k < l ? MUL_AVX(v[k], echelle[i*8 + k]) : _mm256_setzero_ps() ;
+      for(k=0; k<8; k++)
+	_mm256_store_ps(x->t[i*8 + k], v[k]) ;
+    }
+}
+
+#endif
+
+static Noyau_aan *choix_aan()
+{
+  switch(simd_niveau())
+    {
+#ifdef SIMD_X86
+    case Simd_avx2:
+      return aan_avx ;
+    case Simd_sse:
+      return aan_sse ;
+#endif
+    default:
+      return aan_scalaire ;
+    }
+}
+
+/*
+ * Table de mise à l'échelle AAN multipliée par "multiplicateurs"
+ * (64 valeurs, par exemple ceux de la quantification) si non NULL.
+ */
+static void echelle_aan(int inverse, const float *multiplicateurs,
+			float echelle[64])
+{
+  double a[8] ;
+  int u, v ;
+
+  for(u=0; u<8; u++)
+    a[u] = u == 0 ? 1 : sqrt(2) * cos(u * M_PI / 16) ;
+  for(u=0; u<8; u++)
+    for(v=0; v<8; v++)
+      {
+	echelle[u*8 + v] = inverse ? a[u] * a[v] / 8 : 1 / (8 * a[u] * a[v]) ;
+	if ( multiplicateurs )
+	  echelle[u*8 + v] *= multiplicateurs[u*8 + v] ;
+      }
+}
+
+/*
+ *****************************************************************************
+ * Entrelacement d'un lot de blocs.
+ *
+ * Le segment de la ligne "y" de la bande couvrant "nb" blocs
+ * à partir du bloc "premier" est une matrice nb x nbe (un bloc
+ * par ligne) : sa transposée est formée des lignes "y*nbe"
+ * à "y*nbe+nbe-1" de "x". "vers_lot" choisit le sens.
+ *
+ * Le cas général passe par "transposition_vue".
+ * Pour un lot complet de blocs 8x8 la transposition 8x8
+ * se fait dans les registres, sans appel ni découpage.
+ *****************************************************************************
+ */
+
+typedef void Entrelacement(int vers_lot, int nbe, int nb, Vue *bande,
+			   int premier, Matrice *x) ;
+
+static void entrelace_vue(int vers_lot, int nbe, int nb, Vue *bande,
+			  int premier, Matrice *x)
+{
+  Vue ligne, lot ;
+  int y ;
+
+  ligne.pas = ligne.width = nbe ;
+  ligne.height = lot.width = nb ;
+  lot.pas = x->pas ;
+  lot.height = nbe ;
+  for(y=0; y<nbe; y++)
+    {
+      ligne.base = VUE_LIGNE(bande, y) + premier*nbe ;
+      lot.base = x->t[y*nbe] ;
+      if ( vers_lot )
+	transposition_vue(&ligne, &lot) ;
+      else
+	transposition_vue(&lot, &ligne) ;
+    }
+}
+
+#ifdef SIMD_X86
+
+static void entrelace_sse(int vers_lot, int nbe, int nb, Vue *bande,
+			  int premier, Matrice *x)
+{
+  __m128 l0, l1, l2, l3 ;
+  float *e, *s ;
+  int y, i, b, pas_e, pas_s ;
+
+  assert(nbe == 8 && nb == LOT) ;
+  for(y=0; y<8; y++)
+    {
+      if ( vers_lot )
+	{
+	  e = VUE_LIGNE(bande, y) + premier*8 ;
+	  pas_e = 8 ;
+	  s = x->t[y*8] ;
+	  pas_s = x->pas ;
+	}
+      else
+	{
+	  e = x->t[y*8] ;
+	  pas_e = x->pas ;
+	  s = VUE_LIGNE(bande, y) + premier*8 ;
+	  pas_s = 8 ;
+	}
+      for(b=0; b<8; b+=4)
+	for(i=0; i<8; i+=4)
+	  {
+	    l0 = _mm_loadu_ps(e + (b  )*pas_e + i) ;
+	    l1 = _mm_loadu_ps(e + (b+1)*pas_e + i) ;
+	    l2 = _mm_loadu_ps(e + (b+2)*pas_e + i) ;
+	    l3 = _mm_loadu_ps(e + (b+3)*pas_e + i) ;
+	    _MM_TRANSPOSE4_PS(l0, l1, l2, l3) ;
+	    _mm_storeu_ps(s + (i  )*pas_s + b, l0) ;
+	    _mm_storeu_ps(s + (i+1)*pas_s + b, l1) ;
+	    _mm_storeu_ps(s + (i+2)*pas_s + b, l2) ;
+	    _mm_storeu_ps(s + (i+3)*pas_s + b, l3) ;
+	  }
+    }
+}
+
+CIBLE_AVX
+static void entrelace_avx(int vers_lot, int nbe, int nb, Vue *bande,
+			  int premier, Matrice *x)
+{
+  __m256 l[8], t[8] ;
+  float *e, *s ;
+  int y, k, pas_e, pas_s ;
+
+  assert(nbe == 8 && nb == LOT) ;
+  for(y=0; y<8; y++)
+    {
+      if ( vers_lot )
+	{
+	  e = VUE_LIGNE(bande, y) + premier*8 ;
+	  pas_e = 8 ;
+	  s = x->t[y*8] ;
+	  pas_s = x->pas ;
+	}
+      else
+	{
+	  e = x->t[y*8] ;
+	  pas_e = x->pas ;
+	  s = VUE_LIGNE(bande, y) + premier*8 ;
+	  pas_s = 8 ;
+	}
+      for(k=0; k<8; k++)
+	l[k] = _mm256_loadu_ps(e + k*pas_e) ;
+      for(k=0; k<8; k+=2)
+	{
+	  t[k  ] = _mm256_unpacklo_ps(l[k], l[k+1]) ;
+	  t[k+1] = _mm256_unpackhi_ps(l[k], l[k+1]) ;
+	}
+      for(k=0; k<8; k+=4)
+	{
+	  l[k  ] = _mm256_shuffle_ps(t[k  ], t[k+2], _MM_SHUFFLE(1,0,1,0)) ;
+	  l[k+1] = _mm256_shuffle_ps(t[k  ], t[k+2], _MM_SHUFFLE(3,2,3,2)) ;
+	  l[k+2] = _mm256_shuffle_ps(t[k+1], t[k+3], _MM_SHUFFLE(1,0,1,0)) ;
+	  l[k+3] = _mm256_shuffle_ps(t[k+1], t[k+3], _MM_SHUFFLE(3,2,3,2)) ;
+	}
+      for(k=0; k<4; k++)
+	{
+	  _mm256_storeu_ps(s + k*pas_s,
+			   _mm256_permute2f128_ps(l[k], l[k+4], 0x20)) ;
+	  _mm256_storeu_ps(s + (k+4)*pas_s,
+			   _mm256_permute2f128_ps(l[k], l[k+4], 0x31)) ;
+	}
+    }
+}
+
+#endif
+
+/*
+ * L'entrelacement d'un lot complet de blocs nbe x nbe
+ */
+static Entrelacement *choix_entrelacement(int nbe)
+{
+  if ( nbe != 8 )
+    return entrelace_vue ;
+  switch(simd_niveau())
+    {
+#ifdef SIMD_X86
+    case Simd_avx2:
+      return entrelace_avx ;
+    case Simd_sse:
+      return entrelace_sse ;
+#endif
+    default:
+      return entrelace_vue ;
+    }
+}
+
+/*
+ *****************************************************************************
+ */
+
+/*
+ * Les coefficients (u,v) tels que v >= longueurs[u] sont mis à 0
+ */
+static void efface_hors_masque(int nbe, const int *longueurs, Matrice *x) {
+    int u, v, b;
+
+    for(u = 0; u < nbe; u++)
+        for(v = longueurs[u]; v < nbe; v++)
+            for(b = 0; b < LOT; b++)
+                x->t[u*nbe + v][b] = 0;
+}
+
+/*
+ * Le plus petit s tel que les coefficients non nuls des blocs du lot
+ * soient tous dans le carré s x s en haut à gauche (0 si tout est nul).
+ * On parcourt les bords des carrés du plus grand au plus petit :
+ * un lot plein s'arrête tout de suite. Les bits de chaque bord sont
+ * réunis par des OU puis testés une fois, sans le bit de signe
+ * (-0 est nul).
+ */
+#ifdef SIMD_X86
+
+#define BITS(L) _mm_or_si128(_mm_load_si128((const __m128i*)(L)),	\
+			     _mm_load_si128((const __m128i*)(L) + 1))
+
+static int etendue_lot(int nbe, const Matrice *x) {
+    __m128i ou, zero = _mm_setzero_si128();
+    int k, j;
+
+    for(k = nbe - 1; k >= 0; k--) {
+        ou = zero;
+        for(j = 0; j <= k; j++)
+            ou = _mm_or_si128(ou, _mm_or_si128(BITS(x->t[k*nbe + j]),
+                                               BITS(x->t[j*nbe + k])));
+        ou = _mm_cmpeq_epi32(_mm_slli_epi32(ou, 1), zero);
+        if(_mm_movemask_epi8(ou) != 0xFFFF)
+            return k + 1;
+    }
+    return 0;
+}
+
+#else
+
+static int etendue_lot(int nbe, const Matrice *x) {
+    unsigned int ou, bits[2*LOT];
+    int k, j, b;
+
+    for(k = nbe - 1; k >= 0; k--) {
+        ou = 0;
+        for(j = 0; j <= k; j++) {
+            memcpy(bits, x->t[k*nbe + j], LOT * sizeof(float));
+            memcpy(bits + LOT, x->t[j*nbe + k], LOT * sizeof(float));
+            for(b = 0; b < 2*LOT; b++)
+                ou |= bits[b];
+        }
+        if(ou << 1)
+            return k + 1;
+    }
+    return 0;
+}
+
+#endif
+
+/*
+ * Transforme les blocs de la bande, "multiplicateurs" (nbe*nbe valeurs
+ * ou NULL) est appliqué aux coefficients : après la DCT ou avant
+ * l'inverse. Pour nbe=8 il est intégré à la mise à l'échelle AAN.
+ *
+ * Si "longueurs" n'est pas NULL (DCT directe seulement) la ligne u
+ * du résultat ne garde que ses longueurs[u] premiers coefficients.
+ * Avec les passes, la DCT des colonnes ne calcule que les lignes
+ * jusqu'à la dernière non vide et celle des lignes ne calcule que
+ * les coefficients gardés. L'AAN ne transforme ni les lignes vides
+ * ni les lignes au delà de la dernière non vide et se réduit
+ * à une somme quand seul le premier coefficient est gardé.
+ *
+ * Pour l'inverse, les coefficients non nuls d'un lot sont souvent
+ * dans un petit carré s x s en haut à gauche. On choisit :
+ *   - s <= 1 : le continu seul, chaque bloc est constant ;
+ *   - s < nbe : les passes creuses ne font que les sommes sur les
+ *     s premiers éléments et celle des colonnes ne transforme que
+ *     les s premières (l'AAN ne fait que la seconde économie) ;
+ *   - sinon le calcul complet.
+ * Les termes omis sont nuls : le résultat est le même au bit près.
+ */
+static void dct_lots(int inverse, int nbe, Vue *bande,
+                     const float *multiplicateurs, const int *longueurs) {
+    const struct dct_plan *plan = dct_plan(nbe);
+    const Matrice *M;
+    struct arene *arene = arene_session();
+    Matrice* x = arene_matrice(arene, nbe*nbe, LOT);
+    Matrice* tmp = arene_matrice(arene, nbe*nbe, LOT);
+    Passe_lot *passe = choix_passe(nbe, 0), *creuse = choix_passe(nbe, 1);
+    const float *c = coefficients_constants(nbe);
+    int ci, ck;
+    Noyau_aan *aan = choix_aan();
+    Entrelacement *complet = choix_entrelacement(nbe), *entrelace;
+    float echelle[64], dc[LOT];
+    int toutes[nbe], colonnes[nbe];
+    int nb_blocs, premier, nb, b, i, l, nu, s;
+
+    assert(bande->height == nbe && bande->width % nbe == 0);
+    assert(!inverse || !longueurs);
+    nb_blocs = bande->width / nbe;
+    M = dct_plan_matrice(plan, inverse);
+    if(c) { /* M est la table constante ou sa transposée */
+        ci = inverse ? 1 : nbe;
+        ck = inverse ? nbe : 1;
+    }
     else {
-        dct_t = allocation_matrice_float(nbe, nbe);
-	    transposition_matrice(dct, dct_t);
+        c = M->t[0];
+        ci = M->pas;
+        ck = 1;
+    }
+    if(nbe == 8)
+        echelle_aan(inverse, multiplicateurs, echelle);
+    nu = nbe;
+    if(longueurs)
+        while(nu > 0 && longueurs[nu-1] == 0)
+            nu--;
+    for(i = 0; i < nbe; i++) {
+        toutes[i] = nbe;
+        colonnes[i] = nu;
     }
+    if(!longueurs)
+        longueurs = toutes;
+
+    for(premier = 0; premier < nb_blocs; premier += LOT) {
+        nb = MIN(LOT, nb_blocs - premier);
+        entrelace = nb == LOT ? complet : entrelace_vue;
+        if(nb < LOT) /* Voies inutilisées du dernier lot */
+            for(i = 0; i < nbe*nbe; i++)
+                for(b = nb; b < LOT; b++)
+                    x->t[i][b] = 0;
+        (*entrelace)(1, nbe, nb, bande, premier, x);
+        s = inverse ? etendue_lot(nbe, x) : nbe;
+        if(nbe == 8) {
+            if(s <= 1) { /* Sortie constante : le continu mis à l'échelle */
+                for(b = 0; b < LOT; b++)
+                    dc[b] = x->t[0][b] * echelle[0];
+                for(i = 0; i < 64; i++)
+                    for(b = 0; b < LOT; b++)
+                        x->t[i][b] = dc[b];
+            }
+            else
+                (*aan)(inverse, x, echelle, s, longueurs);
+        }
+        else {
+            if(inverse && multiplicateurs)
+                for(l = 0; l < s; l++)
+                    for(i = 0; i < s; i++)
+                        for(b = 0; b < LOT; b++)
+                            x->t[l*nbe + i][b] *= multiplicateurs[l*nbe + i];
+            if(s <= 1) { /* Les deux passes réduites à un produit */
+                for(b = 0; b < LOT; b++)
+                    dc[b] = x->t[0][b];
+                for(l = 0; l < nbe; l++)
+                    for(i = 0; i < nbe; i++)
+                        for(b = 0; b < LOT; b++)
+                            x->t[l*nbe + i][b] = c[i*ci] * (c[l*ci] * dc[b]);
+            }
+            else if(s < nbe) {
+                (*creuse)(nbe, c, ci, ck, x, tmp, 1, nbe, s, toutes, s);
+                (*creuse)(nbe, c, ci, ck, tmp, x, nbe, 1, nbe, toutes, s);
+            }
+            else {
+                (*passe)(nbe, c, ci, ck, x, tmp, 1, nbe,    /* Colonnes */
+                         nbe, colonnes, nbe);
+                (*passe)(nbe, c, ci, ck, tmp, x, nbe, 1,    /* Lignes */
+                         nu, longueurs, nbe);
+            }
+            if(longueurs != toutes)
+                efface_hors_masque(nbe, longueurs, x);
+            if(!inverse && multiplicateurs)
+                for(i = 0; i < nbe*nbe; i++)
+                    for(b = 0; b < LOT; b++)
+                        x->t[i][b] *= multiplicateurs[i];
+        }
+        (*entrelace)(0, nbe, nb, bande, premier, x);
+    }
+    arene_rend(arene, x);
+}
+
+/*
+ * "bande" a nbe lignes et une largeur multiple de nbe :
+ * chacun des blocs nbe x nbe est transformé sur place.
+ * Pour nbe=8 c'est la DCT AAN.
+ */
+void dct_bande(int inverse, int nbe, Vue *bande) {
+    dct_lots(inverse, nbe, bande, NULL, NULL);
+}
+
+/*
+ * Le multiplicateur de la quantification du coefficient (i,j)
+ */
+static float multiplicateur(int i, int j, int qualite, int inverse) {
+  float quant = 1 + (i+j+1)*qualite;
+  return inverse ? quant : 1.f/quant;
+}
+
+/*
+ * DCT puis quantification de chaque bloc de la bande
+ * (ou déquantification puis DCT inverse) :
+ * pour nbe=8 la quantification ne coûte rien de plus.
+ */
+void dct_quantification_bande(int inverse, int nbe, int qualite, Vue *bande) {
+    struct arene *arene = arene_session();
+    Matrice *m = arene_matrice(arene, 1, nbe*nbe);
+    int i, j;
 
-    Matrice* tmp = allocation_matrice_float(nbe, nbe);
-    produit_matrices_float(dct, image, tmp);
-    produit_matrices_float(tmp, dct_t, image);
+    for(i = 0; i < nbe; i++)
+        for(j = 0; j < nbe; j++)
+            m->t[0][i*nbe + j] = multiplicateur(i, j, qualite, inverse);
+    dct_lots(inverse, nbe, bande, m->t[0], NULL);
+    arene_rend(arene, m);
+}
+
+/*
+ * Le masque des coefficients de la DCT d'un bloc de pixels (0 à 255)
+ * qui peuvent être non nuls après quantification et arrondi.
+ *
+ * Le coefficient (u,v) est la somme des pixels multipliés par
+ * D(u,y) D(v,x). Si P(u) et N(u) sont les sommes des D(u,y)
+ * positifs et négatifs (en valeur absolue), il est au plus
+ * 255 max(P(u)P(v) + N(u)N(v), P(u)N(v) + N(u)P(v)) en valeur
+ * absolue. Si cette borne quantifiée reste sous 0.5 (avec une marge
+ * pour les erreurs de calcul) le coefficient est toujours nul.
+ * Avec qualite=0 rien n'est éliminé.
+ *
+ * Si "coupure" est positive, on ne garde de plus que les "coupure"
+ * premiers coefficients du parcours en zigzag (avec perte cette fois).
+ *
+ * Le masque est rendu ligne par ligne : les coefficients (u,v)
+ * gardés sont ceux pour lesquels v < longueurs[u].
+ * La fonction retourne le nombre de coefficients calculés.
+ */
+int dct_masque(int nbe, int qualite, int coupure, int *longueurs) {
+    const Matrice *D = dct_plan_matrice(dct_plan(nbe), 0);
+    float positif[nbe], negatif[nbe], borne;
+    int rang[nbe*nbe];
+    int u, v, y, x, k, total;
+
+    for(u = 0; u < nbe; u++) {
+        positif[u] = negatif[u] = 0;
+        for(y = 0; y < nbe; y++)
+            if(D->t[u][y] > 0)
+                positif[u] += D->t[u][y];
+            else
+                negatif[u] -= D->t[u][y];
+    }
+    x = y = 0;
+    for(k = 0; k < nbe*nbe; k++) {
+        rang[y*nbe + x] = k;
+        if(k != nbe*nbe - 1)
+            zigzag(nbe, &y, &x);
+    }
+    total = 0;
+    for(u = 0; u < nbe; u++) {
+        longueurs[u] = 0;
+        for(v = 0; v < nbe; v++) {
+            if(coupure > 0 && rang[u*nbe + v] >= coupure)
+                continue;
+            borne = 255 * MAX(positif[u]*positif[v] + negatif[u]*negatif[v],
+                              positif[u]*negatif[v] + negatif[u]*positif[v]);
+            if(borne * multiplicateur(u, v, qualite, 0) * 1.001 < 0.5)
+                continue;
+            longueurs[u] = v + 1;
+        }
+        total += longueurs[u];
+    }
+    return total;
+}
 
-    liberation_matrice_float(dct);
-    liberation_matrice_float(dct_t);
-    liberation_matrice_float(tmp);
+/*
+ * DCT directe des blocs de la bande ne calculant que les coefficients
+ * du masque donné par "dct_masque" : les autres valent 0.
+ */
+void dct_elaguee_bande(int nbe, const int *longueurs, Vue *bande) {
+    dct_lots(0, nbe, bande, NULL, longueurs);
 }
 
 /*
@@ -41,16 +1044,41 @@ void dct_image(int inverse, int nbe, Matrice *image) {
  * Si inverse est vrai, on déquantifie.
  * Attention, on reste en calculs flottant (en sortie aussi).
  */
-void quantification(int nbe, int qualite, Matrice *extrait, int inverse) {
+CORPS void corps_quantification(int nbe, const float *m, Vue *extrait) {
   for(int i=0; i<nbe; i++) {
-    for(int j=0; j<nbe; j++) {
-      float quant = 1 + (i+j+1)*qualite;
-      if(!inverse) quant = 1.f/quant;
-      extrait->t[i][j] = extrait->t[i][j] * quant;
-    }
+    float *ligne = VUE_LIGNE(extrait, i);
+    for(int j=0; j<nbe; j++)
+      ligne[j] = ligne[j] * m[i+j];
   }
 }
 
+/*
+ * Le multiplicateur ne dépend que de la diagonale i+j :
+ * 2*nbe-1 valeurs, calculées une fois par bloc.
+ * Les tailles courantes ont des boucles de longueur constante.
+ */
+void quantification_vue(int nbe, int qualite, Vue *extrait, int inverse) {
+  float m[2*nbe - 1];
+
+  for(int d=0; d<2*nbe-1; d++)
+    m[d] = multiplicateur(d, 0, qualite, inverse);
+  switch(nbe) {
+  case 8: corps_quantification(8, m, extrait); break;
+  case 16: corps_quantification(16, m, extrait); break;
+  case 32: corps_quantification(32, m, extrait); break;
+  default: corps_quantification(nbe, m, extrait); break;
+  }
+}
+
+void quantification(int nbe, int qualite, Matrice *extrait, int inverse) {
+  struct arene *arene = arene_session();
+  Matrice *copie;
+  Vue v = arene_vue(arene, extrait, &copie);
+
+  quantification_vue(nbe, qualite, &v, inverse);
+  arene_rend_vue(arene, copie, extrait);
+}
+
 /*
  * ZIGZAG.
  * On fournit à cette fonction les coordonnées d'un point
@@ -97,77 +1125,149 @@ void zigzag(int nbe, int *y, int *x) {
 }
 
 /*
- * Extraction d'une matrice de l'image (le résultat est déjà alloué).
- * La sous-image carrée à la position et de la taille indiquée
- * est stockée dans matrice "extrait"
+ * Parcours en zigzag d'un bloc rangé ligne par ligne :
+ * "sortie[k]" est la k-ième case du parcours de "entree".
+ * L'inverse range "entree[k]" dans la k-ième case de "sortie".
+ * Pour les tailles ayant une table constante c'est une permutation
+ * de longueur fixe, sinon on suit "zigzag".
+ */
+CORPS void permutation(int n, const short *ordre, const float *entree,
+		       float *sortie, int inverse)
+ {
+  int k ;
+
+  if ( inverse )
+    for(k=0; k<n; k++)
+      sortie[ordre[k]] = entree[k] ;
+  else
+    for(k=0; k<n; k++)
+      sortie[k] = entree[ordre[k]] ;
+ }
+
+void zigzag_bloc(int nbe, const float *entree, float *sortie, int inverse)
+ {
+  int k, x, y ;
+
+  switch(nbe)
+    {
+    case 8: permutation(64, zigzag_8, entree, sortie, inverse) ; return ;
+    case 16: permutation(256, zigzag_16, entree, sortie, inverse) ; return ;
+    case 32: permutation(1024, zigzag_32, entree, sortie, inverse) ; return ;
+    }
+  x = y = 0 ;
+  for(k=0; k<nbe*nbe; k++)
+    {
+      if ( inverse )
+	sortie[y*nbe + x] = entree[k] ;
+      else
+	sortie[k] = entree[y*nbe + x] ;
+      if ( k != nbe*nbe - 1 )
+	zigzag(nbe, &y, &x) ;
+    }
+ }
+
+/*
+ * Conversion de l'image en flottants.
+ * La matrice a des dimensions multiples de "nbe",
+ * les pixels hors de l'image valent 0.
  */
 
-static void extrait_matrice(int y, int x, int nbe
-			    , const struct image *entree
-			    , Matrice *extrait
-			    )
+static void image_vers_matrice(const struct image *entree, Matrice *m)
  {
   int i, j ;
 
-  for(j=0;j<nbe;j++)
-    for(i=0;i<nbe;i++)
-      if ( j+y < entree->hauteur && i+x < entree->largeur )
-	extrait->t[j][i] = entree->pixels[j+y][i+x] ;
+  for(j=0;j<m->height;j++)
+    for(i=0;i<m->width;i++)
+      if ( j < entree->hauteur && i < entree->largeur )
+	m->t[j][i] = entree->pixels[j][i] ;
       else
-	extrait->t[j][i] = 0 ;
+	m->t[j][i] = 0 ;
  }
 
 /*
- * Insertion d'une matrice de l'image.
  * C'est l'opération inverse de la précédente.
  */
 
-static void insert_matrice(int y, int x, int nbe
-			   , Matrice *extrait
-			   , struct image *sortie
-			   )
+static void matrice_vers_image(const Matrice *m, struct image *sortie)
  {
   int i, j ;
 
-  for(j=0;j<nbe;j++)
-    for(i=0;i<nbe;i++)
-      if ( j+y < sortie->hauteur && i+x < sortie->largeur )
-	{
-	  if ( extrait->t[j][i] < 0 )
-	    sortie->pixels[j+y][i+x] = 0 ;
-	  else
-	    {
-	      if ( extrait->t[j][i] > 255 )
-		sortie->pixels[j+y][i+x] = 255 ;
-	      else
-		sortie->pixels[j+y][i+x] = rint(extrait->t[j][i]) ;
-	    }
-	}
+  for(j=0;j<sortie->hauteur;j++)
+    for(i=0;i<sortie->largeur;i++)
+      {
+	if ( m->t[j][i] < 0 )
+	  sortie->pixels[j][i] = 0 ;
+	else
+	  {
+	    if ( m->t[j][i] > 255 )
+	      sortie->pixels[j][i] = 255 ;
+	    else
+	      sortie->pixels[j][i] = rint(m->t[j][i]) ;
+	  }
+      }
  }
 
+/*
+ * L'image convertie en flottants, empruntée à l'arène
+ */
+static Matrice *matrice_image(int nbe, const struct image *image)
+ {
+  int hauteur = (image->hauteur + nbe - 1) / nbe * nbe ;
+  int largeur = (image->largeur + nbe - 1) / nbe * nbe ;
+
+  arene_reserve(arene_session(), arene_taille_matrice(hauteur, largeur)
+		+ 2*arene_taille_matrice(nbe*nbe, LOT)) ;
+  return arene_matrice(arene_session(), hauteur, largeur) ;
+ }
 
 /*
  * Compression d'une l'image :
- * Pour chaque petit carré on fait la dct et l'on stocke dans un fichier
+ * Pour chaque petit carré on fait la dct et l'on stocke dans un fichier.
+ * Chaque ligne de carrés est une vue dans l'image convertie en flottants,
+ * transformée sur place d'un seul appel.
+ * Si "longueurs" n'est pas NULL c'est la DCT élaguée.
  */
-void compresse_image(int nbe, const struct image *entree, FILE *f)
+static void compresse_bandes(int nbe, const int *longueurs,
+			     const struct image *entree, FILE *f)
  {
-  static Matrice *tmp = NULL ;
+  Matrice *m ;
+  Vue bande ;
   int i, j, k ;
 
-  if ( tmp == NULL )
-    {
-      tmp = allocation_matrice_float(nbe, nbe) ;
-    }
+  m = matrice_image(nbe, entree) ;
+  image_vers_matrice(entree, m) ;
 
   for(j=0;j<entree->hauteur;j+=nbe)
-    for(i=0;i<entree->largeur;i+=nbe)
-      {
-	extrait_matrice(j, i, nbe, entree, tmp) ;
-	dct_image(0, nbe, tmp) ;
+    {
+      bande = vue_matrice(m, j, 0, nbe, m->width) ;
+      if ( longueurs )
+	dct_elaguee_bande(nbe, longueurs, &bande) ;
+      else
+	dct_bande(0, nbe, &bande) ;
+      for(i=0;i<entree->largeur;i+=nbe)
 	for(k=0; k<nbe; k++)
-	  assert(fwrite(tmp->t[k], sizeof(tmp->t[0][0]), nbe, f) == nbe) ;
-      }
+	  assert(fwrite(VUE_LIGNE(&bande, k) + i, sizeof(float), nbe, f)
+		 == nbe) ;
+    }
+  arene_rend(arene_session(), m) ;
+ }
+
+void compresse_image(int nbe, const struct image *entree, FILE *f)
+ {
+  compresse_bandes(nbe, NULL, entree, f) ;
+ }
+
+/*
+ * Compression ne calculant que les coefficients qui peuvent
+ * survivre à la quantification "qualite" et à la "coupure" en zigzag.
+ */
+void compresse_image_elaguee(int nbe, int qualite, int coupure,
+			     const struct image *entree, FILE *f)
+ {
+  int longueurs[nbe] ;
+
+  dct_masque(nbe, qualite, coupure, longueurs) ;
+  compresse_bandes(nbe, longueurs, entree, f) ;
  }
 
 /*
@@ -177,20 +1277,21 @@ void compresse_image(int nbe, const struct image *entree, FILE *f)
  */
 void decompresse_image(int nbe, struct image *entree, FILE *f)
  {
-  static Matrice *tmp = NULL ;
+  Matrice *m ;
+  Vue bande ;
   int i, j, k ;
 
-  if ( tmp == NULL )
-    {
-      tmp = allocation_matrice_float(nbe, nbe) ;
-    }
+  m = matrice_image(nbe, entree) ;
 
   for(j=0;j<entree->hauteur;j+=nbe)
-    for(i=0;i<entree->largeur;i+=nbe)
-      {
+    {
+      bande = vue_matrice(m, j, 0, nbe, m->width) ;
+      for(i=0;i<entree->largeur;i+=nbe)
 	for(k=0; k<nbe; k++)
-	  assert(fread(tmp->t[k], sizeof(tmp->t[0][0]), nbe, f) == nbe) ;
-	dct_image(1, nbe, tmp) ;
-	insert_matrice(j, i, nbe, tmp, entree) ;
-      }
+	  assert(fread(VUE_LIGNE(&bande, k) + i, sizeof(float), nbe, f)
+		 == nbe) ;
+      dct_bande(1, nbe, &bande) ;
+    }
+  matrice_vers_image(m, entree) ;
+  arene_rend(arene_session(), m) ;
  }
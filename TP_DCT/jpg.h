@@ -10,10 +10,18 @@
 struct image ;
 
 void dct_image(int inverse, int nbe, Matrice *image) ;
+void dct_vue(int inverse, int nbe, Vue *bloc) ;
+void dct_bande(int inverse, int nbe, Vue *bande) ;
+void dct_quantification_bande(int inverse, int nbe, int qualite, Vue *bande) ;
+int dct_masque(int nbe, int qualite, int coupure, int *longueurs) ;
+void dct_elaguee_bande(int nbe, const int *longueurs, Vue *bande) ;
 void quantification(int nbe, int qualite, Matrice *extrait, int inverse) ;
+void quantification_vue(int nbe, int qualite, Vue *extrait, int inverse) ;
 void zigzag(int nbe, int *y, int *x) ;
+void zigzag_bloc(int nbe, const float *entree, float *sortie, int inverse) ;
 
 void compresse_image(int nbe, const struct image *entree, FILE *f) ; /**/
+void compresse_image_elaguee(int nbe, int qualite, int coupure, const struct image *entree, FILE *f) ; /**/
 void decompresse_image(int nbe, struct image *entree, FILE *f) ; /**/
 
 #endif
@@ -1,6 +1,393 @@
 #include "bases.h"
 #include "matrice.h"
 #include "jpg.h"
+#include "simd.h"
+#include "dct.h"
+#include "tables.h"
+
+/*
+ * Une vue "nbe" x "nbe" en (y,x) d'une grande matrice doit donner
+ * exactement le même résultat que la fonction sur une matrice
+ * et ne rien modifier autour.
+ */
+static void compare_vue(int nbe, int y, int x,
+			void (*f_vue)(int nbe, Vue *v, int parametre),
+			void (*f_matrice)(int nbe, Matrice *m, int parametre),
+			int parametre)
+{
+  Matrice *grande, *bloc ;
+  Vue v ;
+  int j, i ;
+
+  grande = allocation_matrice_float(y + nbe + 3, x + nbe + 5) ;
+  bloc = allocation_matrice_float(nbe, nbe) ;
+  for(j=0; j<grande->height; j++)
+    for(i=0; i<grande->width; i++)
+      grande->t[j][i] = (j*17 + i*5) % 256 ;
+  for(j=0; j<nbe; j++)
+    for(i=0; i<nbe; i++)
+      bloc->t[j][i] = grande->t[j+y][i+x] ;
+
+  v = vue_matrice(grande, y, x, nbe, nbe) ;
+  (*f_vue)(nbe, &v, parametre) ;
+  (*f_matrice)(nbe, bloc, parametre) ;
+
+  for(j=0; j<grande->height; j++)
+    for(i=0; i<grande->width; i++)
+      if ( j>=y && j<y+nbe && i>=x && i<x+nbe )
+	{
+	  if ( grande->t[j][i] != bloc->t[j-y][i-x] )
+	    {
+	      eprintf("[%d][%d] = %g au lieu de %g\n", j-y, i-x
+		      , grande->t[j][i], bloc->t[j-y][i-x]) ;
+	      return ;
+	    }
+	}
+      else if ( grande->t[j][i] != (j*17 + i*5) % 256 )
+	{
+	  eprintf("[%d][%d] hors de la vue a été modifié\n", j, i) ;
+	  return ;
+	}
+  liberation_matrice_float(grande) ;
+  liberation_matrice_float(bloc) ;
+}
+
+static void dct_v(int nbe, Vue *v, int inverse) { dct_vue(inverse, nbe, v) ; }
+static void dct_m(int nbe, Matrice *m, int inverse) { dct_image(inverse, nbe, m) ; }
+static void quantif_v(int nbe, Vue *v, int inverse)
+{ quantification_vue(nbe, 3, v, inverse) ; }
+static void quantif_m(int nbe, Matrice *m, int inverse)
+{ quantification(nbe, 3, m, inverse) ; }
+
+void dct_vue_tst()
+{
+  compare_vue(8, 3, 11, dct_v, dct_m, 0) ;
+  compare_vue(8, 8, 0, dct_v, dct_m, 1) ;
+  compare_vue(13, 1, 2, dct_v, dct_m, 0) ;
+}
+
+/*
+ * L'inverse de blocs dont les coefficients non nuls sont dans un carré
+ * s x s passe par les chemins creux. Les 8 premiers blocs forment
+ * un lot creux, les 8 suivants sont les mêmes mais le dernier est plein :
+ * ce lot passe par le calcul complet, qui doit donner les mêmes bits.
+ */
+static void inverse_creuse_tst()
+{
+  static int tailles[] = { 8, 5, 16, 32 } ;
+  Matrice *m ;
+  Vue bande ;
+  int n, t, nbe, s, b, j, i ;
+
+  for(n=Simd_scalaire; n<=Simd_avx2; n++)
+    for(t=0; t<TAILLE(tailles); t++)
+      for(s=0; s<=5; s++)
+	{
+	  simd_force(n) ;
+	  nbe = tailles[t] ;
+	  m = allocation_matrice_float(nbe, 16 * nbe) ;
+	  for(b=0; b<16; b++)
+	    for(j=0; j<nbe; j++)
+	      for(i=0; i<nbe; i++)
+		m->t[j][b*nbe + i] = ( b == 15 || (j < s && i < s) )
+		  ? ((b%8)*13 + j*31 + i*7) % 41 - 20 : 0 ;
+
+	  bande = vue_matrice(m, 0, 0, nbe, m->width) ;
+	  dct_bande(1, nbe, &bande) ;
+
+	  for(b=0; b<7; b++)
+	    for(j=0; j<nbe; j++)
+	      for(i=0; i<nbe; i++)
+		if ( m->t[j][b*nbe + i] != m->t[j][(b+8)*nbe + i] )
+		  {
+		    eprintf("nbe=%d s=%d %s : bloc %d [%d][%d] = %g au lieu de %g\n"
+			    , nbe, s, simd_noms[n], b, j, i
+			    , m->t[j][b*nbe + i], m->t[j][(b+8)*nbe + i]) ;
+		    return ;
+		  }
+	  liberation_matrice_float(m) ;
+	}
+}
+
+/*
+ * Chaque bloc de la bande doit être transformé comme par "dct_vue".
+ * Pour nbe=8 (DCT AAN) le résultat doit être le même, au bit près,
+ * pour tous les niveaux SIMD.
+ */
+void dct_bande_tst()
+{
+  static int cas[][3] = { {8, 1, 0}, {8, 11, 1}, {8, 16, 0}, {5, 13, 1},
+			  {16, 3, 0}, {32, 9, 1} } ;
+  static const float *constantes[] = { dct_16, dct_32 } ;
+  Matrice *m, *r, *aan[TAILLE(cas)] ;
+  Vue bande, bloc ;
+  int c, n, j, i, nbe ;
+
+  /* Les tables générées doivent être celles de "coef_dct" */
+  for(c=0; c<TAILLE(constantes); c++)
+    {
+      nbe = 16 << c ;
+      m = allocation_matrice_float(nbe, nbe) ;
+      coef_dct(m) ;
+      for(j=0; j<nbe; j++)
+	for(i=0; i<nbe; i++)
+	  if ( constantes[c][j*nbe + i] != m->t[j][i] )
+	    {
+	      eprintf("tables.h : dct_%d[%d][%d] = %g au lieu de %g\n"
+		      , nbe, j, i, constantes[c][j*nbe + i], m->t[j][i]) ;
+	      return ;
+	    }
+      liberation_matrice_float(m) ;
+    }
+
+  for(n=Simd_scalaire; n<=Simd_avx2; n++)
+    for(c=0; c<TAILLE(cas); c++)
+      {
+	simd_force(n) ;
+	nbe = cas[c][0] ;
+	m = allocation_matrice_float(nbe + 2, nbe * cas[c][1] + 3) ;
+	r = allocation_matrice_float(nbe + 2, nbe * cas[c][1] + 3) ;
+	for(j=0; j<m->height; j++)
+	  for(i=0; i<m->width; i++)
+	    m->t[j][i] = r->t[j][i] = (j*31 + i*7) % 256 ;
+
+	bande = vue_matrice(m, 1, 2, nbe, nbe * cas[c][1]) ;
+	dct_bande(cas[c][2], nbe, &bande) ;
+	for(i=0; i<cas[c][1]; i++)
+	  {
+	    bloc = vue_matrice(r, 1, 2 + i*nbe, nbe, nbe) ;
+	    dct_vue(cas[c][2], nbe, &bloc) ;
+	  }
+
+	for(j=0; j<m->height; j++)
+	  for(i=0; i<m->width; i++)
+	    if ( fabs(m->t[j][i] - r->t[j][i]) > 1e-3 * (1 + fabs(r->t[j][i]))
+		 || (nbe == 8 && n != Simd_scalaire
+		     && m->t[j][i] != aan[c]->t[j][i]) )
+	      {
+		eprintf("nbe=%d, %d blocs, %s : [%d][%d] = %g au lieu de %g\n"
+			, nbe, cas[c][1], simd_noms[n], j, i
+			, m->t[j][i], r->t[j][i]) ;
+		return ;
+	      }
+	if ( n == Simd_scalaire )
+	  aan[c] = m ;
+	else
+	  liberation_matrice_float(m) ;
+	liberation_matrice_float(r) ;
+      }
+  for(c=0; c<TAILLE(cas); c++)
+    liberation_matrice_float(aan[c]) ;
+
+  inverse_creuse_tst() ;
+}
+
+/*
+ * Comme "dct_bande" puis "quantification_vue" sur chaque bloc
+ * (dans l'autre sens pour l'inverse).
+ */
+void dct_quantification_bande_tst()
+{
+  static int cas[][3] = { {8, 9, 0}, {8, 9, 1}, {5, 3, 0}, {5, 3, 1} } ;
+  Matrice *m, *r ;
+  Vue bande, bloc ;
+  int c, j, i, nbe, inverse ;
+
+  for(c=0; c<TAILLE(cas); c++)
+    {
+      nbe = cas[c][0] ;
+      inverse = cas[c][2] ;
+      m = allocation_matrice_float(nbe, nbe * cas[c][1]) ;
+      r = allocation_matrice_float(nbe, nbe * cas[c][1]) ;
+      for(j=0; j<m->height; j++)
+	for(i=0; i<m->width; i++)
+	  m->t[j][i] = r->t[j][i] = (j*31 + i*7) % 256 - 128 ;
+
+      bande = vue_matrice(m, 0, 0, nbe, m->width) ;
+      dct_quantification_bande(inverse, nbe, 3, &bande) ;
+
+      bande = vue_matrice(r, 0, 0, nbe, r->width) ;
+      if ( !inverse )
+	dct_bande(0, nbe, &bande) ;
+      for(i=0; i<cas[c][1]; i++)
+	{
+	  bloc = vue_matrice(r, 0, i*nbe, nbe, nbe) ;
+	  quantification_vue(nbe, 3, &bloc, inverse) ;
+	}
+      if ( inverse )
+	dct_bande(1, nbe, &bande) ;
+
+      for(j=0; j<m->height; j++)
+	for(i=0; i<m->width; i++)
+	  if ( fabs(m->t[j][i] - r->t[j][i]) > 1e-3 * (1 + fabs(r->t[j][i])) )
+	    {
+	      eprintf("nbe=%d inverse=%d : [%d][%d] = %g au lieu de %g\n"
+		      , nbe, inverse, j, i, m->t[j][i], r->t[j][i]) ;
+	      return ;
+	    }
+      liberation_matrice_float(m) ;
+      liberation_matrice_float(r) ;
+    }
+}
+
+/*
+ * Avec une coupure seule, ce sont exactement les "coupure" premières
+ * cases du zigzag. Avec la quantification seule, un coefficient hors
+ * du masque doit être nul après quantification et arrondi,
+ * même pour les blocs qui maximisent les hautes fréquences.
+ */
+void dct_masque_tst()
+{
+  static int tailles[] = { 5, 8, 16 } ;
+  int longueurs[16] ;
+  Matrice *m ;
+  Vue bloc ;
+  int t, nbe, coupure, k, x, y, motif, total ;
+
+  for(t=0; t<TAILLE(tailles); t++)
+    {
+      nbe = tailles[t] ;
+      if ( dct_masque(nbe, 0, 0, longueurs) != nbe*nbe )
+	{
+	  eprintf("nbe=%d : sans quantification ni coupure tout est gardé\n"
+		  , nbe) ;
+	  return ;
+	}
+      for(coupure=1; coupure<=nbe*nbe; coupure++)
+	{
+	  total = dct_masque(nbe, 0, coupure, longueurs) ;
+	  x = y = 0 ;
+	  for(k=0; k<nbe*nbe; k++)
+	    {
+	      if ( (x < longueurs[y]) != (k < coupure) || total != coupure )
+		{
+		  eprintf("nbe=%d coupure=%d : (%d,%d) rang %d mal masqué\n"
+			  , nbe, coupure, y, x, k) ;
+		  return ;
+		}
+	      if ( k != nbe*nbe - 1 )
+		zigzag(nbe, &y, &x) ;
+	    }
+	}
+
+      total = dct_masque(nbe, 200, 0, longueurs) ;
+      if ( total == nbe*nbe || longueurs[0] == 0 )
+	{
+	  eprintf("nbe=%d : masque %d pour une quantification forte\n"
+		  , nbe, total) ;
+	  return ;
+	}
+      m = allocation_matrice_float(nbe, nbe) ;
+      bloc = vue_matrice(m, 0, 0, nbe, nbe) ;
+      for(motif=0; motif<4; motif++)
+	{
+	  for(y=0; y<nbe; y++)
+	    for(x=0; x<nbe; x++)
+	      switch(motif)
+		{
+		case 0: m->t[y][x] = 255 ; break ;
+		case 1: m->t[y][x] = (x+y)%2 ? 255 : 0 ; break ;
+		case 2: m->t[y][x] = x%2 ? 0 : 255 ; break ;
+		default: m->t[y][x] = (y*37 + x*101) % 256 ; break ;
+		}
+	  dct_vue(0, nbe, &bloc) ;
+	  quantification_vue(nbe, 200, &bloc, 0) ;
+	  for(y=0; y<nbe; y++)
+	    for(x=longueurs[y]; x<nbe; x++)
+	      if ( roundf(m->t[y][x]) != 0 )
+		{
+		  eprintf("nbe=%d motif %d : (%d,%d) = %g hors du masque\n"
+			  , nbe, motif, y, x, m->t[y][x]) ;
+		  return ;
+		}
+	}
+      liberation_matrice_float(m) ;
+    }
+}
+
+/*
+ * Les coefficients gardés sont exactement ceux de "dct_bande",
+ * les autres sont nuls.
+ */
+void dct_elaguee_bande_tst()
+{
+  static int cas[][3] = { {8, 11, 10}, {8, 9, 1}, {8, 5, 3}, {5, 9, 7},
+			  {16, 3, 40}, {32, 9, 100},
+			  {32, 2, 0}, {12, 3, 1} } ;
+  int longueurs[32] ;
+  Matrice *m, *r ;
+  Vue bande ;
+  int c, j, i, nbe, garde ;
+
+  for(c=0; c<TAILLE(cas); c++)
+    {
+      nbe = cas[c][0] ;
+      m = allocation_matrice_float(nbe, nbe * cas[c][1]) ;
+      r = allocation_matrice_float(nbe, nbe * cas[c][1]) ;
+      for(j=0; j<m->height; j++)
+	for(i=0; i<m->width; i++)
+	  m->t[j][i] = r->t[j][i] = (j*31 + i*7) % 256 ;
+
+      dct_masque(nbe, cas[c][2] ? 0 : 100, cas[c][2], longueurs) ;
+      bande = vue_matrice(m, 0, 0, nbe, m->width) ;
+      dct_elaguee_bande(nbe, longueurs, &bande) ;
+      bande = vue_matrice(r, 0, 0, nbe, r->width) ;
+      dct_bande(0, nbe, &bande) ;
+
+      for(j=0; j<m->height; j++)
+	for(i=0; i<m->width; i++)
+	  {
+	    garde = i % nbe < longueurs[j] ;
+	    if ( m->t[j][i] != (garde ? r->t[j][i] : 0) )
+	      {
+		eprintf("nbe=%d coupure=%d : [%d][%d] = %g au lieu de %g\n"
+			, nbe, cas[c][2], j, i, m->t[j][i]
+			, garde ? r->t[j][i] : 0) ;
+		return ;
+	      }
+	  }
+      liberation_matrice_float(m) ;
+      liberation_matrice_float(r) ;
+    }
+}
+
+void quantification_vue_tst()
+{
+  static int tailles[] = { 5, 8, 16, 32 } ;
+  Matrice *m ;
+  Vue v ;
+  float attendu ;
+  int t, nbe, inverse, j, i ;
+
+  compare_vue(8, 5, 7, quantif_v, quantif_m, 0) ;
+  compare_vue(8, 0, 16, quantif_v, quantif_m, 1) ;
+
+  /* Les tailles spécialisées calculent exactement la même chose */
+  for(t=0; t<TAILLE(tailles); t++)
+    for(inverse=0; inverse<2; inverse++)
+      {
+	nbe = tailles[t] ;
+	m = allocation_matrice_float(nbe, nbe) ;
+	for(j=0; j<nbe; j++)
+	  for(i=0; i<nbe; i++)
+	    m->t[j][i] = j*nbe + i ;
+	v = vue_matrice(m, 0, 0, nbe, nbe) ;
+	quantification_vue(nbe, 7, &v, inverse) ;
+	for(j=0; j<nbe; j++)
+	  for(i=0; i<nbe; i++)
+	    {
+	      attendu = 1 + (i+j+1)*7 ;
+	      attendu = (j*nbe + i) * (inverse ? attendu : 1.f/attendu) ;
+	      if ( m->t[j][i] != attendu )
+		{
+		  eprintf("nbe=%d inverse=%d [%d][%d] = %g au lieu de %g\n"
+			  , nbe, inverse, j, i, m->t[j][i], attendu) ;
+		  return ;
+		}
+	    }
+	liberation_matrice_float(m) ;
+      }
+}
 
 void dct_image_tst()
 {
@@ -80,6 +467,42 @@ void quantification_tst()
 }
 
 
+/*
+ * Le parcours doit suivre "zigzag", les tailles ayant une table
+ * constante comme les autres.
+ */
+void zigzag_bloc_tst()
+{
+  float entree[33*33], sortie[33*33], retour[33*33] ;
+  int nbe, k, x, y ;
+
+  for(nbe=1; nbe<=33; nbe++)
+    {
+      for(k=0; k<nbe*nbe; k++)
+	entree[k] = k ;
+      zigzag_bloc(nbe, entree, sortie, 0) ;
+      x = y = 0 ;
+      for(k=0; k<nbe*nbe; k++)
+	{
+	  if ( sortie[k] != y*nbe + x )
+	    {
+	      eprintf("nbe=%d : case %d du parcours = %g au lieu de %d\n"
+		      , nbe, k, sortie[k], y*nbe + x) ;
+	      return ;
+	    }
+	  if ( k != nbe*nbe - 1 )
+	    zigzag(nbe, &y, &x) ;
+	}
+      zigzag_bloc(nbe, sortie, retour, 1) ;
+      for(k=0; k<nbe*nbe; k++)
+	if ( retour[k] != entree[k] )
+	  {
+	    eprintf("nbe=%d : l'inverse ne redonne pas le bloc\n", nbe) ;
+	    return ;
+	  }
+    }
+}
+
 void zigzag_tst()
 {
 #define ZZ(N,Y,X) old_i=i ; old_j=j ; zigzag(N,&j,&i) ; if ( i!=X || j!=Y ) eprintf("Mauvais zigzag dans carré de coté %d.\nAprès X=%d Y=%d j'attend X=%d Y=%d et vous donnez X=%d Y=%d\n", N,old_i, old_j,X,Y,i,j) ;
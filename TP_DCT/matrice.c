@@ -1,10 +1,13 @@
 #include "bases.h"
 #include "image.h"
 #include "matrice.h"
+#include "simd.h"
+#include "pool.h"
+#include "arene.h"
 
 /*
- * Allocation d'une matrice carrée de float.
- * (tableau de pointeur sur tableau de flottants)
+ * Allocation d'une matrice de float.
+ * (tableau de pointeur sur les lignes d'un unique bloc de flottants)
  */
 
 Matrice * allocation_matrice_float(int height, int width)
@@ -13,13 +16,13 @@ Matrice * allocation_matrice_float(int height, int width)
   ALLOUER(tmp, 1);
   tmp->width = width;
   tmp->height = height;
+  tmp->pas = PAS_ALIGNE(width, sizeof(float));
 
-  float** tmpmat;
-  ALLOUER(tmpmat, height);
+  ALLOUER(tmp->t, height);
+  ALLOUER_ALIGNE(tmp->donnees, height * tmp->pas);
 
   for (int i = 0; i < height; ++i)
-      ALLOUER(tmpmat[i], width);
-  tmp->t = tmpmat;
+      tmp->t[i] = MATRICE_LIGNE(tmp, i);
 return tmp ; /* pour enlever un warning du compilateur */
 }
 
@@ -29,37 +32,286 @@ return tmp ; /* pour enlever un warning du compilateur */
 
 void liberation_matrice_float(Matrice *m)
 {
-    for (int i = 0; i < m->height; ++i)
-        free(m->t[i]);
+    free(m->donnees);
     free(m->t);
     free(m);
 }
 
 
 /*
- * Produit matriciel de matrices carrées (le résultat est déjà alloué).
+ * Vue sur le rectangle "height" x "width" commençant en (y,x)
+ */
+
+Vue vue_matrice(const Matrice *m, int y, int x, int height, int width)
+{
+  Vue v ;
+
+  assert(m->donnees) ;
+  assert(y >= 0 && x >= 0) ;
+  assert(y + height <= m->height && x + width <= m->width) ;
+  v.base = MATRICE_LIGNE(m, y) + x ;
+  v.pas = m->pas ;
+  v.width = width ;
+  v.height = height ;
+  return v ;
+}
+
+/*
+ * Produit matriciel (le résultat est déjà alloué).
  *             resultat = a * b 
+ *
+ * "a" est de taille HxK, "b" de taille KxW et "resultat" HxW.
+ *
+ * Le calcul est découpé en blocs de BLOC_K lignes de "b"
+ * et BLOC_W colonnes pour que le morceau de "b" utilisé reste
+ * dans le cache. Dans chaque bloc, un noyau calcule 4 lignes
+ * du résultat à la fois en gardant les sommes dans des registres :
+ * chaque ligne de "b" chargée sert 4 fois.
+ * Toutes les lectures de "b" se font le long des lignes.
  */
 
-void produit_matrices_float(const Matrice *a, const Matrice *b,
-			    Matrice *resultat)
+#define BLOC_K 128
+#define BLOC_W 256
+
+/*
+ * resultat[j..j+nj][i0..i1] += a[j..j+nj][k0..k1] * b[k0..k1][i0..i1]
+ */
+static void noyau_scalaire(const Vue *a, const Vue *b,
+			   Vue *resultat, int j, int nj,
+			   int i0, int i1, int k0, int k1)
+{
+  int jj, i, k ;
+
+  for(jj=j; jj<j+nj; jj++)
+    {
+      float *r = VUE_LIGNE(resultat, jj) ;
+      for(k=k0; k<k1; k++)
+	{
+	  const float aa = VUE_LIGNE(a, jj)[k], *bb = VUE_LIGNE(b, k) ;
+	  for(i=i0; i<i1; i++)
+	    r[i] += aa * bb[i] ;
+	}
+    }
+}
+
+#ifdef SIMD_X86
+
+/*
+ * 4 lignes et 8 colonnes : 8 registres SSE de sommes.
+ */
+static void noyau_sse(const Vue *a, const Vue *b,
+		      Vue *resultat, int j, int i, int k0, int k1)
+{
+  __m128 c[4][2], b0, b1, aa ;
+  int k, l ;
+
+  for(l=0; l<4; l++)
+    {
+      c[l][0] = _mm_loadu_ps(VUE_LIGNE(resultat, j+l) + i) ;
+      c[l][1] = _mm_loadu_ps(VUE_LIGNE(resultat, j+l) + i + 4) ;
+    }
+  for(k=k0; k<k1; k++)
+    {
+      b0 = _mm_loadu_ps(VUE_LIGNE(b, k) + i) ;
+      b1 = _mm_loadu_ps(VUE_LIGNE(b, k) + i + 4) ;
+      for(l=0; l<4; l++)
+	{
+	  aa = _mm_set1_ps(VUE_LIGNE(a, j+l)[k]) ;
+	  c[l][0] = _mm_add_ps(c[l][0], _mm_mul_ps(aa, b0)) ;
+	  c[l][1] = _mm_add_ps(c[l][1], _mm_mul_ps(aa, b1)) ;
+	}
+    }
+  for(l=0; l<4; l++)
+    {
+      _mm_storeu_ps(VUE_LIGNE(resultat, j+l) + i, c[l][0]) ;
+      _mm_storeu_ps(VUE_LIGNE(resultat, j+l) + i + 4, c[l][1]) ;
+    }
+}
+
+/*
+ * 4 lignes et 16 colonnes : 8 registres AVX de sommes.
+ */
+CIBLE_AVX2
+static void noyau_avx2(const Vue *a, const Vue *b,
+		       Vue *resultat, int j, int i, int k0, int k1)
+{
+  __m256 c[4][2], b0, b1, aa ;
+  int k, l ;
+
+  for(l=0; l<4; l++)
+    {
+      c[l][0] = _mm256_loadu_ps(VUE_LIGNE(resultat, j+l) + i) ;
+      c[l][1] = _mm256_loadu_ps(VUE_LIGNE(resultat, j+l) + i + 8) ;
+    }
+  for(k=k0; k<k1; k++)
+    {
+      b0 = _mm256_loadu_ps(VUE_LIGNE(b, k) + i) ;
+      b1 = _mm256_loadu_ps(VUE_LIGNE(b, k) + i + 8) ;
+      for(l=0; l<4; l++)
+	{
+	  aa = _mm256_broadcast_ss(&VUE_LIGNE(a, j+l)[k]) ;
+	  c[l][0] = _mm256_fmadd_ps(aa, b0, c[l][0]) ;
+	  c[l][1] = _mm256_fmadd_ps(aa, b1, c[l][1]) ;
+	}
+    }
+  for(l=0; l<4; l++)
+    {
+      _mm256_storeu_ps(VUE_LIGNE(resultat, j+l) + i, c[l][0]) ;
+      _mm256_storeu_ps(VUE_LIGNE(resultat, j+l) + i + 8, c[l][1]) ;
+    }
+}
+
+#endif
+
+/*
+ * Le noyau vectoriel utilisable et le nombre de colonnes qu'il traite.
+ */
+typedef void Noyau_produit(const Vue *a, const Vue *b,
+			   Vue *resultat, int j, int i, int k0, int k1) ;
+
+static Noyau_produit *choix_noyau(int *largeur)
+{
+  switch(simd_niveau())
+    {
+#ifdef SIMD_X86
+    case Simd_avx2:
+      *largeur = 16 ;
+      return noyau_avx2 ;
+    case Simd_sse:
+      *largeur = 8 ;
+      return noyau_sse ;
+#endif
+    default:
+      *largeur = 0 ;
+      return NULL ;
+    }
+}
+
+/*
+ * Calcul des lignes j0 à j1 du résultat.
+ * Les paquets de 4 lignes partent de multiples de 4 quel que soit "j0"
+ * (si "j0" en est un) : le résultat ne dépend pas du découpage.
+ */
+static void produit_lignes(const Vue *a, const Vue *b,
+			   Vue *resultat, int j0, int j1)
+{
+  int j, i, k0, k1, i0, i1, largeur ;
+  Noyau_produit *noyau ;
+
+  noyau = choix_noyau(&largeur) ;
+
+  for(j=j0; j<j1; j++)
+    memset(VUE_LIGNE(resultat, j), 0, resultat->width * sizeof(float)) ;
+
+  for(k0=0; k0<a->width; k0+=BLOC_K)
+    {
+      k1 = MIN(k0 + BLOC_K, a->width) ;
+      for(i0=0; i0<b->width; i0+=BLOC_W)
+	{
+	  i1 = MIN(i0 + BLOC_W, b->width) ;
+	  for(j=j0; j+4<=j1 && noyau; j+=4)
+	    {
+	      for(i=i0; i+largeur<=i1; i+=largeur)
+		(*noyau)(a, b, resultat, j, i, k0, k1) ;
+#ifdef SIMD_X86
+	      if ( largeur > 8 && i+8 <= i1 )
+		{
+		  noyau_sse(a, b, resultat, j, i, k0, k1) ;
+		  i += 8 ;
+		}
+#endif
+	      noyau_scalaire(a, b, resultat, j, 4, i, i1, k0, k1) ;
+	    }
+	  noyau_scalaire(a, b, resultat, j, j1 - j, i0, i1, k0, k1) ;
+	}
+    }
+}
+
+/*
+ *****************************************************************************
+ * Versions parallèles : les lignes du résultat sont découpées en bandes,
+ * une bande par tâche du pool de threads.
+ * Chaque élément est calculé exactement comme en séquentiel.
+ * En dessous des seuils (en nombre d'opérations), le coût
+ * de réveil des threads dépasse le gain.
+ *****************************************************************************
+ */
+
+#define SEUIL_PRODUIT       (1 << 21)
+#define SEUIL_VECTEUR       (1 << 18)
+#define SEUIL_TRANSPOSITION (1 << 18)
+#define TACHES_PAR_THREAD   4
+
+struct bandes
+{
+  const Vue *a, *b ;
+  Vue *resultat ;
+  const Matrice *m ;		/* Pour le produit matrice vecteur */
+  const float *v ;
+  float *vr ;
+  int bande ;			/* Lignes par tâche */
+  int nb_lignes ;
+} ;
+
+/*
+ * Prépare le découpage de "nb_lignes" en bandes de hauteur multiple
+ * de "multiple" et retourne le nombre de tâches.
+ */
+static int decoupe_bandes(struct bandes *b, int nb_lignes, int multiple)
+{
+  int nb ;
+
+  nb = pool_nb_threads() * TACHES_PAR_THREAD ;
+  b->nb_lignes = nb_lignes ;
+  b->bande = (nb_lignes + nb - 1) / nb ;
+  b->bande = MAX((b->bande + multiple - 1) / multiple * multiple, multiple) ;
+  return (nb_lignes + b->bande - 1) / b->bande ;
+}
+
+static void tache_produit(void *d, int tache)
+{
+  struct bandes *b = d ;
+
+  produit_lignes(b->a, b->b, b->resultat, tache * b->bande,
+		 MIN((tache + 1) * b->bande, b->nb_lignes)) ;
+}
+
+void produit_vues(const Vue *a, const Vue *b, Vue *resultat)
  {
-  int j, i, k ;
-  float s ;
+  struct bandes bandes ;
 
   assert(a->width == b->height) ;
-  assert(a->width == b->width) ;
-  assert(a->height == b->height) ;
-  assert(a->width == resultat->width) ;
   assert(a->height == resultat->height) ;
-  for(j=0; j<a->height; j++)
-    for(i=0; i<a->width; i++)
-      {
-	s = 0 ;
-	for(k=0;k<a->width;k++)
-	  s += a->t[j][k]*b->t[k][i] ;
-	resultat->t[j][i] = s ;
-      }
+  assert(b->width == resultat->width) ;
+  assert(resultat->base != a->base && resultat->base != b->base) ;
+
+  if ( (double)a->height * a->width * b->width < SEUIL_PRODUIT )
+    {
+      produit_lignes(a, b, resultat, 0, a->height) ;
+      return ;
+    }
+  bandes.a = a ;
+  bandes.b = b ;
+  bandes.resultat = resultat ;
+  pool_execute(decoupe_bandes(&bandes, a->height, 4), tache_produit, &bandes) ;
+ }
+
+void produit_matrices_float(const Matrice *a, const Matrice *b,
+			    Matrice *resultat)
+ {
+  struct arene *arene = arene_session() ;
+  Matrice *ca, *cb, *cr ;
+  Vue va, vb, vr ;
+
+  assert(resultat != a && resultat != b) ;
+
+  va = arene_vue(arene, a, &ca) ;
+  vb = arene_vue(arene, b, &cb) ;
+  vr = arene_vue(arene, resultat, &cr) ;
+  produit_vues(&va, &vb, &vr) ;
+  arene_rend_vue(arene, cr, resultat) ;
+  arene_rend_vue(arene, cb, NULL) ;
+  arene_rend_vue(arene, ca, NULL) ;
  }
 
 /*
@@ -68,13 +320,13 @@ void produit_matrices_float(const Matrice *a, const Matrice *b,
  * Le résultat est supposé annulé
  */
 
-void produit_matrice_vecteur(const Matrice *a, const float *v,
-				    float *resultat)
+static void produit_vecteur_lignes(const Matrice *a, const float *v,
+				   float *resultat, int j0, int j1)
  {
   int j, i ;
   float s ;
 
-  for(j=0; j<a->height; j++)
+  for(j=j0; j<j1; j++)
     {
       s = 0 ;
       for(i=0;i<a->width;i++)
@@ -83,21 +335,223 @@ void produit_matrice_vecteur(const Matrice *a, const float *v,
     }
  }
 
+static void tache_vecteur(void *d, int tache)
+{
+  struct bandes *b = d ;
+
+  produit_vecteur_lignes(b->m, b->v, b->vr, tache * b->bande,
+			 MIN((tache + 1) * b->bande, b->nb_lignes)) ;
+}
+
+void produit_matrice_vecteur(const Matrice *a, const float *v,
+				    float *resultat)
+ {
+  struct bandes bandes ;
+
+  if ( (double)a->height * a->width < SEUIL_VECTEUR )
+    {
+      produit_vecteur_lignes(a, v, resultat, 0, a->height) ;
+      return ;
+    }
+  bandes.m = a ;
+  bandes.v = v ;
+  bandes.vr = resultat ;
+  pool_execute(decoupe_bandes(&bandes, a->height, 1), tache_vecteur, &bandes) ;
+ }
+
 /*
- * Transposition d'une matrice carrée (le résultat est déjà alloué).
+ * Transposition d'une matrice (le résultat est déjà alloué).
  *        a_t est la transposée de a
+ *
+ * Seul le coin haut gauche "height" x "width" du résultat est calculé.
+ *
+ * Lire "a" par colonnes vide le cache sur les grandes images.
+ * On coupe donc récursivement le rectangle en deux (dans sa plus
+ * grande dimension) jusqu'à ce qu'il tienne dans le cache,
+ * puis on le transpose par carrés de 8x8 (ou 4x4) dans les registres.
+ */
+
+#define TRANSPOSITION_FEUILLE 64
+
+/*
+ * resultat[j..j+nj][i..i+ni] = transposée de a[i..i+ni][j..j+nj]
  */
+static void transposition_scalaire(const Vue *a, Vue *resultat,
+				   int j, int nj, int i, int ni)
+{
+  int jj, ii ;
+
+  for(jj=j; jj<j+nj; jj++)
+    for(ii=i; ii<i+ni; ii++)
+      VUE_LIGNE(resultat, jj)[ii] = VUE_LIGNE(a, ii)[jj] ;
+}
+
+#ifdef SIMD_X86
+
+static void transposition_sse(const Vue *a, Vue *resultat,
+			      int j, int i)
+{
+  __m128 l0, l1, l2, l3 ;
+
+  l0 = _mm_loadu_ps(VUE_LIGNE(a, i  ) + j) ;
+  l1 = _mm_loadu_ps(VUE_LIGNE(a, i+1) + j) ;
+  l2 = _mm_loadu_ps(VUE_LIGNE(a, i+2) + j) ;
+  l3 = _mm_loadu_ps(VUE_LIGNE(a, i+3) + j) ;
+  _MM_TRANSPOSE4_PS(l0, l1, l2, l3) ;
+  _mm_storeu_ps(VUE_LIGNE(resultat, j  ) + i, l0) ;
+  _mm_storeu_ps(VUE_LIGNE(resultat, j+1) + i, l1) ;
+  _mm_storeu_ps(VUE_LIGNE(resultat, j+2) + i, l2) ;
+  _mm_storeu_ps(VUE_LIGNE(resultat, j+3) + i, l3) ;
+}
+
+CIBLE_AVX2
+static void transposition_avx2(const Vue *a, Vue *resultat,
+			       int j, int i)
+{
+  __m256 l[8], t[8] ;
+  int k ;
+
+  for(k=0; k<8; k++)
+    l[k] = _mm256_loadu_ps(VUE_LIGNE(a, i+k) + j) ;
+  for(k=0; k<8; k+=2)
+    {
+      t[k  ] = _mm256_unpacklo_ps(l[k], l[k+1]) ;
+      t[k+1] = _mm256_unpackhi_ps(l[k], l[k+1]) ;
+    }
+  for(k=0; k<8; k+=4)
+    {
+      l[k  ] = _mm256_shuffle_ps(t[k  ], t[k+2], _MM_SHUFFLE(1,0,1,0)) ;
+      l[k+1] = _mm256_shuffle_ps(t[k  ], t[k+2], _MM_SHUFFLE(3,2,3,2)) ;
+      l[k+2] = _mm256_shuffle_ps(t[k+1], t[k+3], _MM_SHUFFLE(1,0,1,0)) ;
+      l[k+3] = _mm256_shuffle_ps(t[k+1], t[k+3], _MM_SHUFFLE(3,2,3,2)) ;
+    }
+  for(k=0; k<4; k++)
+    {
+      _mm256_storeu_ps(VUE_LIGNE(resultat, j+k  ) + i,
+		       _mm256_permute2f128_ps(l[k], l[k+4], 0x20)) ;
+      _mm256_storeu_ps(VUE_LIGNE(resultat, j+k+4) + i,
+		       _mm256_permute2f128_ps(l[k], l[k+4], 0x31)) ;
+    }
+}
+
+#endif
+
+typedef void Noyau_transposition(const Vue *a, Vue *resultat,
+				 int j, int i) ;
+
+static void transposition_feuille(const Vue *a, Vue *resultat,
+				  int j, int nj, int i, int ni,
+				  Noyau_transposition *noyau, int cote)
+{
+  int jj, ii ;
+
+  for(jj=j; jj+cote<=j+nj && noyau; jj+=cote)
+    {
+      for(ii=i; ii+cote<=i+ni; ii+=cote)
+	(*noyau)(a, resultat, jj, ii) ;
+      transposition_scalaire(a, resultat, jj, cote, ii, i+ni-ii) ;
+    }
+  transposition_scalaire(a, resultat, jj, j+nj-jj, i, ni) ;
+}
+
+static void transposition_recursive(const Vue *a, Vue *resultat,
+				    int j, int nj, int i, int ni,
+				    Noyau_transposition *noyau, int cote)
+{
+  int moitie ;
+
+  if ( nj <= TRANSPOSITION_FEUILLE && ni <= TRANSPOSITION_FEUILLE )
+    transposition_feuille(a, resultat, j, nj, i, ni, noyau, cote) ;
+  else if ( nj >= ni )
+    {
+      moitie = (nj/2 + 7) & ~7 ;
+      transposition_recursive(a, resultat, j, moitie, i, ni, noyau, cote) ;
+      transposition_recursive(a, resultat, j+moitie, nj-moitie, i, ni,
+			      noyau, cote) ;
+    }
+  else
+    {
+      moitie = (ni/2 + 7) & ~7 ;
+      transposition_recursive(a, resultat, j, nj, i, moitie, noyau, cote) ;
+      transposition_recursive(a, resultat, j, nj, i+moitie, ni-moitie,
+			      noyau, cote) ;
+    }
+}
+
+static Noyau_transposition *choix_transposition(int *cote)
+{
+  switch(simd_niveau())
+    {
+#ifdef SIMD_X86
+    case Simd_avx2:
+      *cote = 8 ;
+      return transposition_avx2 ;
+    case Simd_sse:
+      *cote = 4 ;
+      return transposition_sse ;
+#endif
+    default:
+      *cote = 0 ;
+      return NULL ;
+    }
+}
+
+static void tache_transposition(void *d, int tache)
+{
+  struct bandes *b = d ;
+  Noyau_transposition *noyau ;
+  int cote, j ;
+
+  noyau = choix_transposition(&cote) ;
+  j = tache * b->bande ;
+  transposition_recursive(b->a, b->resultat, j,
+			  MIN(b->bande, b->nb_lignes - j),
+			  0, b->resultat->width, noyau, cote) ;
+}
+
+void transposition_vue(const Vue *a, Vue *resultat)
+ {
+  Noyau_transposition *noyau ;
+  struct bandes bandes ;
+  int cote ;
+
+  assert(a->width == resultat->height) ;
+  assert(a->height == resultat->width) ;
+  assert(a->base != resultat->base) ;
+
+  if ( (double)a->width * a->height < SEUIL_TRANSPOSITION )
+    {
+      noyau = choix_transposition(&cote) ;
+      transposition_recursive(a, resultat, 0, resultat->height,
+			      0, resultat->width, noyau, cote) ;
+      return ;
+    }
+  bandes.a = a ;
+  bandes.resultat = resultat ;
+  pool_execute(decoupe_bandes(&bandes, resultat->height, 8),
+	       tache_transposition, &bandes) ;
+ }
 
 void transposition_matrice_partielle(const Matrice *a, Matrice *resultat,
 				     int width, int height)
  {
-  int i, j ;
+  struct arene *arene = arene_session() ;
+  Matrice *ca, *cr ;
+  Vue va, vr ;
 
   assert(a->width == resultat->height) ;
   assert(a->height == resultat->width) ;
-  for(j=0;j<height;j++)
-    for(i=0;i<width;i++)
-      resultat->t[j][i] = a->t[i][j] ;
+  assert(a != resultat) ;
+
+  va = arene_vue(arene, a, &ca) ;
+  vr = arene_vue(arene, resultat, &cr) ;
+  va.height = width ;
+  va.width = height ;
+  vr.height = height ;
+  vr.width = width ;
+  transposition_vue(&va, &vr) ;
+  arene_rend_vue(arene, cr, resultat) ;
+  arene_rend_vue(arene, ca, NULL) ;
  }
 
 void transposition_matrice(const Matrice *a, Matrice *resultat)
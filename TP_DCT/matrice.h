@@ -10,8 +10,37 @@
 typedef struct {
   int width, height ;
   float **t ;
+  float *donnees ;		/* Bloc unique aligné, NULL si non alloué ici */
+  int pas ;			/* Nombre de flottants entre deux lignes */
 } Matrice ;
 
+/*
+ * Les matrices créées par "allocation_matrice_float" sont stockées
+ * dans un seul bloc aligné sur ALIGNEMENT octets.
+ * Chaque ligne est aussi alignée car "pas" est un multiple
+ * de ALIGNEMENT/sizeof(float) supérieur ou égal à "width".
+ * Les pointeurs "t[j]" pointent dans ce bloc.
+ *
+ * Les nouveaux noyaux de calcul peuvent utiliser directement
+ * "donnees" et "pas" au lieu de "t[j]".
+ */
+#define MATRICE_LIGNE(M,J) ( (M)->donnees + (J)*(M)->pas )
+#define MATRICE_ELEMENT(M,J,I) ( MATRICE_LIGNE(M,J)[I] )
+
+/*
+ * Vue sur un rectangle de flottants rangés par lignes :
+ * l'élément (j,i) est base[j*pas + i].
+ * Une vue ne possède pas ses données : un bloc d'image ou le coin
+ * haut gauche d'une matrice se transforme sur place, sans copie.
+ */
+typedef struct {
+  float *base ;
+  int pas ;
+  int width, height ;
+} Vue ;
+
+#define VUE_LIGNE(V,J) ( (V)->base + (J)*(V)->pas )
+
 Matrice* allocation_matrice_float(int height, int width) ;
 void liberation_matrice_float(Matrice*) ;
 
@@ -19,10 +48,16 @@ void liberation_matrice_float(Matrice*) ;
  * Fonctions gracieusement fournies
  */
 
-void produit_matrices_float(const Matrice *a, const Matrice *b, Matrice *resultat) ; /**/
+void produit_matrices_float(const Matrice *a, const Matrice *b, Matrice *resultat) ;
+/*
+ * La matrice doit avoir été créée par "allocation_matrice_float"
+ */
+Vue vue_matrice(const Matrice *m, int y, int x, int height, int width) ;
+void produit_vues(const Vue *a, const Vue *b, Vue *resultat) ;
+void transposition_vue(const Vue *a, Vue *resultat) ;
 void transposition_matrice(const Matrice *a, Matrice *resultat) ; /**/
-void transposition_matrice_partielle(const Matrice *a, Matrice *resultat, int width, int height) ; /**/
-void produit_matrice_vecteur(const Matrice *a, const float *v, float *resultat) ; /**/
+void transposition_matrice_partielle(const Matrice *a, Matrice *resultat, int width, int height) ;
+void produit_matrice_vecteur(const Matrice *a, const float *v, float *resultat) ;
 void affiche_matrice(const Matrice *a, FILE *f) ; /**/
 
 struct image* creation_image_a_partir_de_matrice_float(const Matrice *m) ; /**/
@@ -1,5 +1,37 @@
 #include "bases.h"
 #include "matrice.h"
+#include "simd.h"
+#include "pool.h"
+
+/*
+ * Les versions parallèles doivent donner exactement
+ * le même résultat que les versions séquentielles.
+ */
+static int identiques(const Matrice *a, const Matrice *b)
+{
+  int j ;
+
+  for(j=0; j<a->height; j++)
+    if ( memcmp(a->t[j], b->t[j], a->width * sizeof(float)) )
+      {
+	eprintf("Avec %d threads, la ligne %d est différente\n"
+		, pool_nb_threads(), j) ;
+	return 0 ;
+      }
+  return 1 ;
+}
+
+static Matrice *matrice_remplie(int height, int width)
+{
+  Matrice *m ;
+  int j, i ;
+
+  m = allocation_matrice_float(height, width) ;
+  for(j=0; j<height; j++)
+    for(i=0; i<width; i++)
+      m->t[j][i] = cos(j*7 + i*3) ;
+  return m ;
+}
 
 void allocation_matrice_float_tst()
 {
@@ -20,6 +52,26 @@ void allocation_matrice_float_tst()
 	  eprintf("Le contenu de la matrice s'auto écrase\n") ;
 	  return ;
 	}
+
+  m = allocation_matrice_float(7, 13) ;
+  if ( m->pas < m->width || (m->pas * sizeof(float)) % ALIGNEMENT )
+    {
+      eprintf("Le pas (%d) n'est pas aligné\n", m->pas) ;
+      return ;
+    }
+  for(j=0; j<m->height; j++)
+    {
+      if ( m->t[j] != MATRICE_LIGNE(m, j) )
+	{
+	  eprintf("La ligne %d n'est pas dans le bloc de données\n", j) ;
+	  return ;
+	}
+      if ( (size_t)m->t[j] % ALIGNEMENT )
+	{
+	  eprintf("La ligne %d n'est pas alignée\n", j) ;
+	  return ;
+	}
+    }
 }
 
 void liberation_matrice_float_tst()
@@ -37,3 +89,282 @@ void liberation_matrice_float_tst()
       return ;
     }
 }
+
+void produit_matrices_float_tst()
+{
+  static int tailles[][3] = { {3,3,3}, {7,19,37}, {8,8,8}, {33,130,70},
+			      {1,300,17}, {64,5,300} } ;
+  Matrice *a, *b, *r, *s1 ;
+  int t, n, j, i, k ;
+  double s ;
+
+  for(n=Simd_scalaire; n<=Simd_avx2; n++)
+    for(t=0; t<TAILLE(tailles); t++)
+      {
+	simd_force(n) ;
+	a = allocation_matrice_float(tailles[t][0], tailles[t][1]) ;
+	b = allocation_matrice_float(tailles[t][1], tailles[t][2]) ;
+	r = allocation_matrice_float(tailles[t][0], tailles[t][2]) ;
+	for(j=0; j<a->height; j++)
+	  for(i=0; i<a->width; i++)
+	    a->t[j][i] = cos(j*3 + i) ;
+	for(j=0; j<b->height; j++)
+	  for(i=0; i<b->width; i++)
+	    b->t[j][i] = sin(j + i*7) ;
+
+	produit_matrices_float(a, b, r) ;
+
+	for(j=0; j<r->height; j++)
+	  for(i=0; i<r->width; i++)
+	    {
+	      s = 0 ;
+	      for(k=0; k<a->width; k++)
+		s += a->t[j][k] * b->t[k][i] ;
+	      if ( fabs(r->t[j][i] - s) > 1e-4 * a->width )
+		{
+		  eprintf("Produit %dx%d * %dx%d en %s\n"
+			  , a->height, a->width, b->height, b->width
+			  , simd_noms[simd_niveau()]) ;
+		  eprintf("[%d][%d] = %g au lieu de %g\n", j, i, r->t[j][i], s) ;
+		  return ;
+		}
+	    }
+	liberation_matrice_float(a) ;
+	liberation_matrice_float(b) ;
+	liberation_matrice_float(r) ;
+      }
+
+  a = matrice_remplie(130, 140) ;
+  b = matrice_remplie(140, 150) ;
+  r = allocation_matrice_float(130, 150) ;
+  s1 = allocation_matrice_float(130, 150) ;
+  pool_limite(1) ;
+  produit_matrices_float(a, b, s1) ;
+  pool_limite(3) ;
+  produit_matrices_float(a, b, r) ;
+  if ( ! identiques(r, s1) )
+    return ;
+  pool_limite(0) ;
+  liberation_matrice_float(a) ;
+  liberation_matrice_float(b) ;
+  liberation_matrice_float(r) ;
+  liberation_matrice_float(s1) ;
+}
+
+void produit_matrice_vecteur_tst()
+{
+  Matrice *a, *r, *s ;
+  int j, i ;
+  float v[700], somme ;
+
+  for(i=0; i<TAILLE(v); i++)
+    v[i] = sin(i) ;
+
+  a = matrice_remplie(13, 7) ;
+  r = allocation_matrice_float(1, 13) ;
+  produit_matrice_vecteur(a, v, r->t[0]) ;
+  for(j=0; j<a->height; j++)
+    {
+      somme = 0 ;
+      for(i=0; i<a->width; i++)
+	somme += a->t[j][i] * v[i] ;
+      if ( r->t[0][j] != somme )
+	{
+	  eprintf("resultat[%d] = %g au lieu de %g\n", j, r->t[0][j], somme) ;
+	  return ;
+	}
+    }
+  liberation_matrice_float(a) ;
+  liberation_matrice_float(r) ;
+
+  a = matrice_remplie(601, 700) ;
+  r = allocation_matrice_float(1, 601) ;
+  s = allocation_matrice_float(1, 601) ;
+  pool_limite(1) ;
+  produit_matrice_vecteur(a, v, s->t[0]) ;
+  pool_limite(3) ;
+  produit_matrice_vecteur(a, v, r->t[0]) ;
+  if ( ! identiques(r, s) )
+    return ;
+  pool_limite(0) ;
+  liberation_matrice_float(a) ;
+  liberation_matrice_float(r) ;
+  liberation_matrice_float(s) ;
+}
+
+void transposition_matrice_partielle_tst()
+{
+  static int tailles[][4] = { {3,5,3,5}, {8,8,8,8}, {37,19,37,19},
+			      {300,200,300,200}, {300,200,151,7},
+			      {129,70,65,35}, {1,1000,1,1000} } ;
+  Matrice *a, *r, *s ;
+  int t, n, j, i ;
+
+  for(n=Simd_scalaire; n<=Simd_avx2; n++)
+    for(t=0; t<TAILLE(tailles); t++)
+      {
+	simd_force(n) ;
+	a = allocation_matrice_float(tailles[t][0], tailles[t][1]) ;
+	r = allocation_matrice_float(tailles[t][1], tailles[t][0]) ;
+	for(j=0; j<a->height; j++)
+	  for(i=0; i<a->width; i++)
+	    a->t[j][i] = 1000*j + i ;
+	for(j=0; j<r->height; j++)
+	  for(i=0; i<r->width; i++)
+	    r->t[j][i] = -1 ;
+
+	/* Coin haut gauche de la transposée : tailles[t][3] lignes */
+	transposition_matrice_partielle(a, r, tailles[t][2], tailles[t][3]) ;
+
+	for(j=0; j<r->height; j++)
+	  for(i=0; i<r->width; i++)
+	    if ( r->t[j][i] != (j<tailles[t][3] && i<tailles[t][2]
+				? 1000*i + j : -1) )
+	      {
+		eprintf("Transposition %dx%d (partielle %dx%d) en %s\n"
+			, a->height, a->width, tailles[t][2], tailles[t][3]
+			, simd_noms[simd_niveau()]) ;
+		eprintf("[%d][%d] = %g\n", j, i, r->t[j][i]) ;
+		return ;
+	      }
+	liberation_matrice_float(a) ;
+	liberation_matrice_float(r) ;
+      }
+
+  a = matrice_remplie(700, 600) ;
+  r = allocation_matrice_float(600, 700) ;
+  s = allocation_matrice_float(600, 700) ;
+  pool_limite(1) ;
+  transposition_matrice_partielle(a, s, 650, 501) ;
+  pool_limite(3) ;
+  transposition_matrice_partielle(a, r, 650, 501) ;
+  for(j=0; j<501; j++)
+    if ( memcmp(r->t[j], s->t[j], 650 * sizeof(float)) )
+      {
+	eprintf("Transposition parallèle : ligne %d différente\n", j) ;
+	return ;
+      }
+  pool_limite(0) ;
+  liberation_matrice_float(a) ;
+  liberation_matrice_float(r) ;
+  liberation_matrice_float(s) ;
+}
+
+void vue_matrice_tst()
+{
+  Matrice *m ;
+  Vue v ;
+  int j, i ;
+
+  m = matrice_remplie(20, 30) ;
+  v = vue_matrice(m, 3, 5, 7, 11) ;
+  if ( v.height != 7 || v.width != 11 || v.pas != m->pas )
+    {
+      eprintf("Vue %dx%d de pas %d\n", v.height, v.width, v.pas) ;
+      return ;
+    }
+  for(j=0; j<v.height; j++)
+    for(i=0; i<v.width; i++)
+      if ( &VUE_LIGNE(&v, j)[i] != &m->t[j+3][i+5] )
+	{
+	  eprintf("La vue (%d,%d) ne pointe pas sur la matrice\n", j, i) ;
+	  return ;
+	}
+  liberation_matrice_float(m) ;
+}
+
+/*
+ * Vérifie que seul le rectangle de la vue a été modifié
+ */
+static int hors_vue_intact(const Matrice *m, const Matrice *origine,
+			   int y, int x, int height, int width)
+{
+  int j, i ;
+
+  for(j=0; j<m->height; j++)
+    for(i=0; i<m->width; i++)
+      if ( (j < y || j >= y+height || i < x || i >= x+width)
+	   && m->t[j][i] != origine->t[j][i] )
+	{
+	  eprintf("[%d][%d] hors de la vue a été modifié\n", j, i) ;
+	  return 0 ;
+	}
+  return 1 ;
+}
+
+void produit_vues_tst()
+{
+  Matrice *a, *b, *r, *ra, *rb, *rr, *origine ;
+  Vue va, vb, vr ;
+  int j, i ;
+
+  /* Produit de sous-rectangles de grandes matrices */
+  a = matrice_remplie(40, 50) ;
+  b = matrice_remplie(60, 70) ;
+  r = matrice_remplie(30, 40) ;
+  origine = matrice_remplie(30, 40) ;
+  va = vue_matrice(a, 2, 3, 13, 21) ;
+  vb = vue_matrice(b, 5, 1, 21, 17) ;
+  vr = vue_matrice(r, 4, 6, 13, 17) ;
+  produit_vues(&va, &vb, &vr) ;
+
+  /* Le même produit sur des matrices normales */
+  ra = allocation_matrice_float(13, 21) ;
+  rb = allocation_matrice_float(21, 17) ;
+  rr = allocation_matrice_float(13, 17) ;
+  for(j=0; j<13; j++)
+    for(i=0; i<21; i++)
+      ra->t[j][i] = a->t[j+2][i+3] ;
+  for(j=0; j<21; j++)
+    for(i=0; i<17; i++)
+      rb->t[j][i] = b->t[j+5][i+1] ;
+  produit_matrices_float(ra, rb, rr) ;
+
+  for(j=0; j<13; j++)
+    for(i=0; i<17; i++)
+      if ( VUE_LIGNE(&vr, j)[i] != rr->t[j][i] )
+	{
+	  eprintf("[%d][%d] = %g au lieu de %g\n", j, i
+		  , VUE_LIGNE(&vr, j)[i], rr->t[j][i]) ;
+	  return ;
+	}
+  if ( ! hors_vue_intact(r, origine, 4, 6, 13, 17) )
+    return ;
+
+  liberation_matrice_float(a) ;
+  liberation_matrice_float(b) ;
+  liberation_matrice_float(r) ;
+  liberation_matrice_float(origine) ;
+  liberation_matrice_float(ra) ;
+  liberation_matrice_float(rb) ;
+  liberation_matrice_float(rr) ;
+}
+
+void transposition_vue_tst()
+{
+  Matrice *a, *r, *origine ;
+  Vue va, vr ;
+  int j, i ;
+
+  a = matrice_remplie(50, 40) ;
+  r = matrice_remplie(40, 50) ;
+  origine = matrice_remplie(40, 50) ;
+  va = vue_matrice(a, 3, 2, 19, 27) ;
+  vr = vue_matrice(r, 1, 9, 27, 19) ;
+  transposition_vue(&va, &vr) ;
+
+  for(j=0; j<27; j++)
+    for(i=0; i<19; i++)
+      if ( r->t[j+1][i+9] != a->t[i+3][j+2] )
+	{
+	  eprintf("[%d][%d] = %g au lieu de %g\n", j, i
+		  , r->t[j+1][i+9], a->t[i+3][j+2]) ;
+	  return ;
+	}
+  if ( ! hors_vue_intact(r, origine, 1, 9, 27, 19) )
+    return ;
+
+  liberation_matrice_float(a) ;
+  liberation_matrice_float(r) ;
+  liberation_matrice_float(origine) ;
+}
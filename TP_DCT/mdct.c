@@ -0,0 +1,130 @@
+#include "bases.h"
+#include "fft.h"
+#include "mdct.h"
+
+/*
+ * Avec M = nbe et la fenêtre w(n) = sin(pi (n + 1/2) / 2M),
+ * le coefficient k de la trame z (2M échantillons) est :
+ *
+ *   X(k) = sqrt(2/M) somme sur n<2M de
+ *              w(n) z(n) cos(pi/M (n + 1/2 + M/2) (k + 1/2))
+ *
+ * Les quatre quarts (a,b,c,d) de la trame fenêtrée sont repliés
+ * en M valeurs (-c' - d, a - b') ou ' renverse l'ordre :
+ * X est la DCT-IV de ce repli. L'inverse est la DCT-IV
+ * (elle est sa propre inverse) suivie du dépliage et de la fenêtre.
+ *
+ * La DCT-IV de taille M se fait par une FFT de taille M/2 :
+ *   v(n) = (u(2n) + i u(M-1-2n)) exp(-i pi (n + 1/4) / M)
+ *   c(k) = FFT(v)(k) exp(-i pi k / M)
+ *   X(2k) = Re c(k)      X(M-1-2k) = -Im c(k)
+ */
+
+struct mdct
+{
+  int nbe ;
+  struct fft *fft ;		/* Taille nbe/2 */
+  float *fenetre ;		/* 2*nbe valeurs */
+  float complex *avant ;	/* Facteurs appliqués avant la FFT */
+  float complex *apres ;	/* Et après, avec la normalisation */
+  float *signal ;		/* Trame courante (directe) */
+  float *historique ;		/* Seconde moitié de l'inverse précédente */
+  float *repli ;		/* nbe valeurs */
+  float complex *travail ;	/* nbe/2 valeurs */
+} ;
+
+struct mdct* open_mdct(int nbe)
+{
+  struct mdct *m ;
+  int n ;
+
+  assert(nbe >= 2 && puissance_de_2(nbe)) ;
+  ALLOUER(m, 1) ;
+  m->nbe = nbe ;
+  m->fft = open_fft(nbe/2) ;
+  ALLOUER(m->fenetre, 2*nbe) ;
+  ALLOUER(m->avant, nbe/2) ;
+  ALLOUER(m->apres, nbe/2) ;
+  ALLOUER(m->signal, 2*nbe) ;
+  ALLOUER(m->historique, nbe) ;
+  ALLOUER(m->repli, nbe) ;
+  ALLOUER(m->travail, nbe/2) ;
+
+  for(n=0; n<2*nbe; n++)
+    m->fenetre[n] = sin(M_PI * (n + 0.5) / (2*nbe)) ;
+  for(n=0; n<nbe/2; n++)	/* Calcul en double */
+    {
+      m->avant[n] = cexp(-I * M_PI * (n + 0.25) / nbe) ;
+      m->apres[n] = sqrt(2. / nbe) * cexp(-I * M_PI * n / nbe) ;
+    }
+  for(n=0; n<2*nbe; n++)
+    m->signal[n] = 0 ;
+  for(n=0; n<nbe; n++)
+    m->historique[n] = 0 ;
+
+  return m ;
+}
+
+void close_mdct(struct mdct *m)
+{
+  close_fft(m->fft) ;
+  free(m->fenetre) ;
+  free(m->avant) ;
+  free(m->apres) ;
+  free(m->signal) ;
+  free(m->historique) ;
+  free(m->repli) ;
+  free(m->travail) ;
+  free(m) ;
+}
+
+/*
+ * DCT-IV normalisée de "u" (nbe valeurs) dans "x"
+ */
+static void dct4(struct mdct *m, const float *u, float *x)
+{
+  int M = m->nbe, n ;
+  float complex c ;
+
+  for(n=0; n<M/2; n++)
+    m->travail[n] = PRODUIT_COMPLEXE(CMPLXF(u[2*n], u[M-1-2*n]), m->avant[n]) ;
+  fft(m->fft, m->travail, 0) ;
+  for(n=0; n<M/2; n++)
+    {
+      c = PRODUIT_COMPLEXE(m->travail[n], m->apres[n]) ;
+      x[2*n] = crealf(c) ;
+      x[M-1-2*n] = -cimagf(c) ;
+    }
+}
+
+void mdct(struct mdct *m, int inverse, const float *entree, float *sortie)
+{
+  int M = m->nbe, h = M/2, n ;
+  const float *w = m->fenetre ;
+  float *z = m->signal, *u = m->repli ;
+
+  if ( !inverse )
+    {
+      memcpy(z + M, entree, M * sizeof(*z)) ;
+      for(n=0; n<h; n++)
+	u[n] = - w[3*h-1-n] * z[3*h-1-n] - w[3*h+n] * z[3*h+n] ;
+      for(n=h; n<M; n++)
+	u[n] = w[n-h] * z[n-h] - w[3*h-1-n] * z[3*h-1-n] ;
+      dct4(m, u, sortie) ;
+      memcpy(z, z + M, M * sizeof(*z)) ;
+    }
+  else
+    {
+      dct4(m, entree, u) ;
+      /* Première moitié de la trame + fin de la précédente */
+      for(n=0; n<h; n++)
+	sortie[n] = m->historique[n] + w[n] * u[n+h] ;
+      for(n=h; n<M; n++)
+	sortie[n] = m->historique[n] - w[n] * u[3*h-1-n] ;
+      /* Seconde moitié gardée pour la trame suivante */
+      for(n=M; n<3*h; n++)
+	m->historique[n-M] = - w[n] * u[3*h-1-n] ;
+      for(n=3*h; n<2*M; n++)
+	m->historique[n-M] = - w[n] * u[n-3*h] ;
+    }
+}
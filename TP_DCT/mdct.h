@@ -0,0 +1,32 @@
+/*
+ * MDCT : DCT modifiée à fenêtres recouvrantes (TDAC).
+ *
+ * Chaque trame transforme les 2*nbe derniers échantillons
+ * (la moitié déjà vue dans la trame précédente) en nbe coefficients.
+ * La fenêtre sinus et la normalisation rendent la transformation
+ * orthogonale : l'addition des moitiés recouvrantes des inverses
+ * annule les repliements et redonne exactement le signal.
+ */
+
+#ifndef MDCT_H
+#define MDCT_H
+
+struct mdct ;
+
+/*
+ * "nbe" doit être une puissance de 2 au moins égale à 2.
+ * L'historique (échantillons ou moitié de trame inverse) est nul.
+ */
+struct mdct* open_mdct(int nbe) ;
+void close_mdct(struct mdct *m) ;
+/*
+ * Directe : "entree" contient les nbe nouveaux échantillons,
+ *           "sortie" les nbe coefficients.
+ * Inverse : "entree" contient nbe coefficients, "sortie" les nbe
+ *           échantillons reconstruits, en retard d'une trame
+ *           (la première trame rendue précède le signal).
+ * Un même "struct mdct" ne doit servir que dans un sens.
+ */
+void mdct(struct mdct *m, int inverse, const float *entree, float *sortie) ;
+
+#endif
@@ -0,0 +1,103 @@
+#include "bases.h"
+#include "mdct.h"
+
+/*
+ * MDCT calculée naïvement (en double) sur une trame de 2*nbe valeurs
+ */
+static void mdct_naive(int nbe, const float *z, double *x)
+{
+  double w ;
+  int k, n ;
+
+  for(k=0; k<nbe; k++)
+    {
+      x[k] = 0 ;
+      for(n=0; n<2*nbe; n++)
+	{
+	  w = sin(M_PI * (n + 0.5) / (2*nbe)) ;
+	  x[k] += w * z[n] * cos(M_PI / nbe * (n + 0.5 + nbe/2.) * (k + 0.5)) ;
+	}
+      x[k] *= sqrt(2. / nbe) ;
+    }
+}
+
+/*
+ * Les trames successives de "mdct" sont comparées
+ * à la formule appliquée aux 2*nbe derniers échantillons.
+ */
+void open_mdct_tst()
+{
+  float signal[3*256], sortie[256] ;
+  double attendu[256] ;
+  struct mdct *m ;
+  int nbe, t, i ;
+
+  for(nbe=2; nbe<=256; nbe*=2)
+    {
+      for(i=0; i<3*nbe; i++)
+	signal[i] = i < nbe ? 0 : (i*37) % 255 - 127 ;
+      m = open_mdct(nbe) ;
+      for(t=0; t<2; t++)
+	{
+	  mdct(m, 0, signal + (t+1)*nbe, sortie) ;
+	  mdct_naive(nbe, signal + t*nbe, attendu) ;
+	  for(i=0; i<nbe; i++)
+	    if ( fabs(sortie[i] - attendu[i]) > 1e-3 * (1 + fabs(attendu[i])) )
+	      {
+		eprintf("mdct(nbe=%d) trame %d [%d] = %g au lieu de %g\n"
+			, nbe, t, i, sortie[i], attendu[i]) ;
+		return ;
+	      }
+	}
+      close_mdct(m) ;
+    }
+}
+
+void close_mdct_tst()
+{
+  struct mdct *m ;
+
+  m = open_mdct(64) ;
+  close_mdct(m) ;
+  if ( open_mdct(64) != m )
+    eprintf("Vous êtes sûr de tout libérer ?\n") ;
+}
+
+/*
+ * Aller-retour en flux : l'inverse redonne le signal avec
+ * une trame de retard (la trame de plus vide les historiques).
+ */
+void mdct_tst()
+{
+  enum { NBE = 64, TRAMES = 10 } ;
+  float signal[(TRAMES+1)*NBE], coefficients[NBE], sortie[(TRAMES+1)*NBE] ;
+  struct mdct *directe, *inverse ;
+  int t, i ;
+
+  for(i=0; i<(TRAMES+1)*NBE; i++)
+    signal[i] = i < TRAMES*NBE ? (i*i*7) % 256 - 128 : 0 ;
+  directe = open_mdct(NBE) ;
+  inverse = open_mdct(NBE) ;
+  for(t=0; t<=TRAMES; t++)
+    {
+      mdct(directe, 0, signal + t*NBE, coefficients) ;
+      mdct(inverse, 1, coefficients, sortie + t*NBE) ;
+    }
+  close_mdct(directe) ;
+  close_mdct(inverse) ;
+
+  for(i=0; i<NBE; i++)
+    if ( fabs(sortie[i]) > 1e-3 )
+      {
+	eprintf("La première trame inverse doit être nulle : [%d] = %g\n"
+		, i, sortie[i]) ;
+	return ;
+      }
+  for(i=0; i<TRAMES*NBE; i++)
+    if ( fabs(sortie[i+NBE] - signal[i]) > 1e-3 )
+      {
+	eprintf("Aller-retour faux en %d : %g au lieu de %g\n"
+		, i, sortie[i+NBE], signal[i]) ;
+	return ;
+      }
+}
@@ -7,6 +7,7 @@
 #include "exception.h"
 #include "matrice.h"
 #include "ondelette.h"
+#include "arene.h"
 
 /*
  * Cette fonction effectue UNE SEULE itération d'une ondelette 1D
@@ -84,27 +85,43 @@ void ondelette_1d(const float *entree, float *sortie, int nbe)
  * 
  */
 
-void ondelette_2d(Matrice *image)
+void ondelette_2d_vue(Vue *image)
 {
     int h = image->height, w = image->width;
-    Matrice* tmp0 = allocation_matrice_float(h, w);
-    Matrice* tmp1 = allocation_matrice_float(w, h);
-    Matrice* tmp2 = allocation_matrice_float(w, h);
+    struct arene *arene = arene_session();
+    Matrice* tmp0 = arene_matrice(arene, h, w);
+    Matrice* tmp1 = arene_matrice(arene, w, h);
+    Matrice* tmp2 = arene_matrice(arene, w, h);
     while(h > 1 || w > 1) {
+        /* Le coin haut gauche de l'image et des intermédiaires */
+        Vue coin = *image, v0, v1, v2;
+        coin.height = h;
+        coin.width = w;
+        v0 = vue_matrice(tmp0, 0, 0, h, w);
+        v1 = vue_matrice(tmp1, 0, 0, w, h);
+        v2 = vue_matrice(tmp2, 0, 0, w, h);
         for(int i = 0; i < h; ++i) {
-            ondelette_1d(image->t[i], tmp0->t[i], w);
+            ondelette_1d(VUE_LIGNE(&coin, i), VUE_LIGNE(&v0, i), w);
         }
-        transposition_matrice_partielle(tmp0, tmp1, h, w);
+        transposition_vue(&v0, &v1);
         for(int i = 0; i < w; ++i) {
-            ondelette_1d(tmp1->t[i], tmp2->t[i], h);
+            ondelette_1d(VUE_LIGNE(&v1, i), VUE_LIGNE(&v2, i), h);
         }
-        transposition_matrice_partielle(tmp2, image, w, h);
+        transposition_vue(&v2, &coin);
         h = (h + 1) / 2;
         w = (w + 1) / 2;
     }
-    liberation_matrice_float(tmp0);
-    liberation_matrice_float(tmp1);
-    liberation_matrice_float(tmp2);
+    arene_rend(arene, tmp0);
+}
+
+void ondelette_2d(Matrice *image)
+{
+    struct arene *arene = arene_session();
+    Matrice *copie;
+    Vue v = arene_vue(arene, image, &copie);
+
+    ondelette_2d_vue(&v);
+    arene_rend_vue(arene, copie, image);
 }
 
 /*
@@ -209,28 +226,52 @@ void ondelette_1d_inverse(const float *entree, float *sortie, int nbe)
     }
 }
 
-void ondelette_2d_inverse_recursive(Matrice *image, int h, int w){
+/*
+ * On commence par le niveau le plus petit : le coin haut gauche
+ * de la taille moitié (arrondie au dessus).
+ */
+void ondelette_2d_inverse_vue(Vue *image)
+{
+    int h = image->height, w = image->width;
     if(h > 1 || w > 1) {
-        ondelette_2d_inverse_recursive(image, (h + 1) / 2, (w + 1) / 2);
+        Vue coin = *image;
+        coin.height = (h + 1) / 2;
+        coin.width = (w + 1) / 2;
+        ondelette_2d_inverse_vue(&coin);
     }
-    Matrice* tmp0 = allocation_matrice_float(image->height, image->width);
-    Matrice* tmp1 = allocation_matrice_float(image->width, image->height);
-    Matrice* tmp2 = allocation_matrice_float(image->width, image->height);
+    struct arene *arene = arene_session();
+    Matrice* tmp0 = arene_matrice(arene, h, w);
+    Matrice* tmp1 = arene_matrice(arene, w, h);
+    Matrice* tmp2 = arene_matrice(arene, w, h);
+    Vue v0 = vue_matrice(tmp0, 0, 0, h, w);
+    Vue v1 = vue_matrice(tmp1, 0, 0, w, h);
+    Vue v2 = vue_matrice(tmp2, 0, 0, w, h);
     for(int i = 0; i < h; ++i) {
-        ondelette_1d_inverse(image->t[i], tmp0->t[i], w);
+        ondelette_1d_inverse(VUE_LIGNE(image, i), VUE_LIGNE(&v0, i), w);
     }
-    transposition_matrice_partielle(tmp0, tmp1, h, w);
+    transposition_vue(&v0, &v1);
     for(int i = 0; i < w; ++i) {
-        ondelette_1d_inverse(tmp1->t[i], tmp2->t[i], h);
+        ondelette_1d_inverse(VUE_LIGNE(&v1, i), VUE_LIGNE(&v2, i), h);
     }
-    transposition_matrice_partielle(tmp2, image, w, h);
-    liberation_matrice_float(tmp0);
-    liberation_matrice_float(tmp1);
-    liberation_matrice_float(tmp2);
+    transposition_vue(&v2, image);
+    arene_rend(arene, tmp0);
 }
+/*
+ * Chaque niveau emprunte puis rend au plus 3 matrices de la taille
+ * de l'image : on les réserve une fois pour toutes les itérations.
+ */
 void ondelette_2d_inverse(Matrice *image)
 {
-   ondelette_2d_inverse_recursive(image, image->height, image->width);
+   struct arene *arene = arene_session();
+   Matrice *copie;
+   Vue v;
+
+   arene_reserve(arene,
+                 arene_taille_matrice(image->height, image->width)
+                 + 2*arene_taille_matrice(image->width, image->height));
+   v = arene_vue(arene, image, &copie);
+   ondelette_2d_inverse_vue(&v);
+   arene_rend_vue(arene, copie, image);
 }
 
 
@@ -7,9 +7,11 @@
 
 void ondelette_1d(const float *entree, float *sortie, int nbe) ;
 void ondelette_2d(Matrice *image) ;
+void ondelette_2d_vue(Vue *image) ;
 
 void ondelette_1d_inverse(const float *entree, float *sortie, int nbe) ;
 void ondelette_2d_inverse(Matrice *image) ;
+void ondelette_2d_inverse_vue(Vue *image) ;
 
 void ondelette_encode_image(float qualite) ; /**/
 void ondelette_decode_image() ; /**/
@@ -314,3 +314,62 @@ void ondelette_2d_inverse_tst()
 }
 
 
+
+/*
+ * L'ondelette d'un rectangle vu dans une grande matrice
+ * est celle du même rectangle copié, et le reste n'est pas modifié.
+ */
+static void compare_ondelette_vue(int y, int x, int hau, int lar,
+				  void (*f_vue)(Vue*),
+				  void (*f_matrice)(Matrice*))
+{
+  Matrice *grande, *bloc ;
+  Vue v ;
+  int j, i ;
+
+  grande = allocation_matrice_float(y + hau + 2, x + lar + 3) ;
+  bloc = allocation_matrice_float(hau, lar) ;
+  for(j=0; j<grande->height; j++)
+    for(i=0; i<grande->width; i++)
+      grande->t[j][i] = (j*7 + i*13) % 100 ;
+  for(j=0; j<hau; j++)
+    for(i=0; i<lar; i++)
+      bloc->t[j][i] = grande->t[j+y][i+x] ;
+
+  v = vue_matrice(grande, y, x, hau, lar) ;
+  (*f_vue)(&v) ;
+  (*f_matrice)(bloc) ;
+
+  for(j=0; j<grande->height; j++)
+    for(i=0; i<grande->width; i++)
+      if ( j>=y && j<y+hau && i>=x && i<x+lar )
+	{
+	  if ( grande->t[j][i] != bloc->t[j-y][i-x] )
+	    {
+	      eprintf("Vue %dx%d : [%d][%d] = %g au lieu de %g\n", hau, lar
+		      , j-y, i-x, grande->t[j][i], bloc->t[j-y][i-x]) ;
+	      return ;
+	    }
+	}
+      else if ( grande->t[j][i] != (j*7 + i*13) % 100 )
+	{
+	  eprintf("[%d][%d] hors de la vue a été modifié\n", j, i) ;
+	  return ;
+	}
+  liberation_matrice_float(grande) ;
+  liberation_matrice_float(bloc) ;
+}
+
+void ondelette_2d_vue_tst()
+{
+  compare_ondelette_vue(3, 5, 11, 17, ondelette_2d_vue, ondelette_2d) ;
+  compare_ondelette_vue(0, 2, 1, 9, ondelette_2d_vue, ondelette_2d) ;
+}
+
+void ondelette_2d_inverse_vue_tst()
+{
+  compare_ondelette_vue(4, 1, 13, 6, ondelette_2d_inverse_vue,
+			ondelette_2d_inverse) ;
+  compare_ondelette_vue(2, 0, 8, 1, ondelette_2d_inverse_vue,
+			ondelette_2d_inverse) ;
+}
@@ -0,0 +1,189 @@
+#include <pthread.h>
+#include "bases.h"
+#include "pool.h"
+
+/*
+ * Les threads sont créés au besoin et ne se terminent jamais.
+ * Chaque appel à "pool_execute" incrémente "generation" pour
+ * réveiller les travailleurs, qui prennent les numéros de tâche
+ * un par un dans "prochaine".
+ *
+ * L'appelant attend que toutes les tâches soient terminées
+ * et qu'aucun travailleur ne soit encore dans le calcul :
+ * un retardataire pourrait sinon prendre une tâche du calcul suivant.
+ */
+
+static struct
+{
+  pthread_mutex_t verrou ;
+  pthread_cond_t travail ;	/* Nouvelle génération */
+  pthread_cond_t termine ;	/* Un travailleur a fini */
+  int nb_travailleurs ;		/* Threads créés, sans l'appelant */
+  int limite ;			/* Threads utilisés, appelant compris */
+  long generation ;
+  int actifs ;			/* Travailleurs dans le calcul */
+  Tache *f ;
+  void *donnees ;
+  int nb_taches ;
+  int prochaine ;		/* Prochaine tâche à prendre */
+  int terminees ;
+} pool = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER,
+	   PTHREAD_COND_INITIALIZER } ;
+
+/* Un seul calcul à la fois */
+static pthread_mutex_t occupe = PTHREAD_MUTEX_INITIALIZER ;
+/* Vrai dans les travailleurs et pendant un calcul */
+static __thread int dans_pool = 0 ;
+
+struct depart
+{
+  int numero ;
+  long generation ;
+} ;
+
+/*
+ * Fait des tâches tant qu'il en reste, retourne le nombre faites.
+ */
+static int execute(Tache *f, void *donnees, int nb_taches)
+{
+  int t, n ;
+
+  n = 0 ;
+  while( (t = __atomic_fetch_add(&pool.prochaine, 1, __ATOMIC_RELAXED))
+	 < nb_taches )
+    {
+      (*f)(donnees, t) ;
+      n++ ;
+    }
+  return n ;
+}
+
+static void *travailleur(void *arg)
+{
+  struct depart *d = arg ;
+  int numero, nb_taches, n ;
+  long vue ;
+  Tache *f ;
+  void *donnees ;
+
+  numero = d->numero ;
+  vue = d->generation ;
+  free(d) ;
+  dans_pool = 1 ;
+
+  pthread_mutex_lock(&pool.verrou) ;
+  for(;;)
+    {
+      while( pool.generation == vue )
+	pthread_cond_wait(&pool.travail, &pool.verrou) ;
+      vue = pool.generation ;
+      if ( numero >= pool.limite - 1 )
+	continue ;
+      f = pool.f ;
+      donnees = pool.donnees ;
+      nb_taches = pool.nb_taches ;
+      pool.actifs++ ;
+      pthread_mutex_unlock(&pool.verrou) ;
+
+      n = execute(f, donnees, nb_taches) ;
+
+      pthread_mutex_lock(&pool.verrou) ;
+      pool.terminees += n ;
+      pool.actifs-- ;
+      pthread_cond_broadcast(&pool.termine) ;
+    }
+  return NULL ;
+}
+
+static int nb_threads_defaut()
+{
+  if ( getenv("THREADS") && atoi(getenv("THREADS")) > 0 )
+    return atoi(getenv("THREADS")) ;
+  return MAX(sysconf(_SC_NPROCESSORS_ONLN), 1) ;
+}
+
+/*
+ * A appeler en possédant "occupe" : aucun calcul n'est en cours.
+ */
+static void change_limite(int nb)
+{
+  struct depart *d ;
+  pthread_t thread ;
+
+  if ( nb <= 0 )
+    nb = nb_threads_defaut() ;
+  pthread_mutex_lock(&pool.verrou) ;
+  __atomic_store_n(&pool.limite, nb, __ATOMIC_RELEASE) ;
+  while( pool.nb_travailleurs < nb - 1 )
+    {
+      ALLOUER(d, 1) ;
+      d->numero = pool.nb_travailleurs++ ;
+      d->generation = pool.generation ;
+      if ( pthread_create(&thread, NULL, travailleur, d) )
+	EXIT ;
+      pthread_detach(thread) ;
+    }
+  pthread_mutex_unlock(&pool.verrou) ;
+}
+
+void pool_limite(int nb)
+{
+  pthread_mutex_lock(&occupe) ;
+  change_limite(nb) ;
+  pthread_mutex_unlock(&occupe) ;
+}
+
+/*
+ * Sans verrou une fois la limite fixée : une tâche peut le demander
+ * pendant que l'appelant de "pool_execute" possède "occupe".
+ */
+int pool_nb_threads()
+{
+  int nb ;
+
+  nb = __atomic_load_n(&pool.limite, __ATOMIC_ACQUIRE) ;
+  if ( nb )
+    return nb ;
+  pthread_mutex_lock(&occupe) ;
+  if ( pool.limite == 0 )
+    change_limite(0) ;
+  pthread_mutex_unlock(&occupe) ;
+  return pool.limite ;
+}
+
+void pool_execute(int nb_taches, Tache *f, void *donnees)
+{
+  int t, n ;
+
+  if ( dans_pool || nb_taches <= 1 || pool_nb_threads() <= 1
+       || pthread_mutex_trylock(&occupe) )
+    {
+      for(t=0; t<nb_taches; t++)
+	(*f)(donnees, t) ;
+      return ;
+    }
+
+  pthread_mutex_lock(&pool.verrou) ;
+  while( pool.actifs )
+    pthread_cond_wait(&pool.termine, &pool.verrou) ;
+  pool.f = f ;
+  pool.donnees = donnees ;
+  pool.nb_taches = nb_taches ;
+  pool.prochaine = 0 ;
+  pool.terminees = 0 ;
+  pool.generation++ ;
+  pthread_cond_broadcast(&pool.travail) ;
+  pthread_mutex_unlock(&pool.verrou) ;
+
+  dans_pool = 1 ;
+  n = execute(f, donnees, nb_taches) ;
+  dans_pool = 0 ;
+
+  pthread_mutex_lock(&pool.verrou) ;
+  pool.terminees += n ;
+  while( pool.terminees < nb_taches || pool.actifs )
+    pthread_cond_wait(&pool.termine, &pool.verrou) ;
+  pthread_mutex_unlock(&pool.verrou) ;
+
+  pthread_mutex_unlock(&occupe) ;
+}
@@ -0,0 +1,31 @@
+/*
+ * Pool de threads pour découper un calcul en tâches indépendantes.
+ */
+
+#ifndef POOL_H
+#define POOL_H
+
+/*
+ * Une tâche reçoit les données communes et son numéro.
+ */
+typedef void Tache(void *donnees, int tache) ;
+
+/*
+ * Exécute les tâches 0 à nb_taches-1 puis retourne.
+ * Le thread appelant travaille aussi.
+ * Si le pool est déjà occupé (appel depuis une tâche ou depuis
+ * un autre thread), les tâches sont faites séquentiellement.
+ */
+void pool_execute(int nb_taches, Tache *f, void *donnees) ;
+/*
+ * Nombre de threads utilisés (appelant compris).
+ * Par défaut la variable d'environnement THREADS,
+ * ou le nombre de processeurs si elle est absente ou nulle.
+ */
+int pool_nb_threads() ;
+/*
+ * Change le nombre de threads utilisés (0 : valeur par défaut).
+ */
+void pool_limite(int nb) ;
+
+#endif
@@ -1,4 +1,7 @@
+#include <pthread.h>
 #include "bases.h"
+#include "matrice.h"
+#include "arene.h"
 #include "psycho.h"
 
 /*
@@ -6,7 +9,7 @@
  *      A1 et A2 leurs amplitudes respectives.
  * La fréquence du son est l'indice dans le tableau "dct".
  *
- * 
+ *
  * Si   C * abs(A1)   <   abs( A2 / (F2 - F1) )
  *   Alors Annuler A1
  *
@@ -26,7 +29,7 @@
  * Il contient déjà les coefficients de la dct
  */
 
-void psycho(int nbe, float *dct, float c)
+void psycho_paires(int nbe, float *dct, float c)
 {
 	for(int F1 = 1; F1 < nbe; F1++){
         float A1 = dct[F1];
@@ -42,3 +45,381 @@ void psycho(int nbe, float *dct, float c)
     }
 }
 
+/*
+ * Les mêmes décisions que "psycho_paires", au bit près,
+ * sans essayer toutes les paires.
+ *
+ * La ligne F1 de la double boucle lit A1 une seule fois
+ * et ne regarde que les F2 > F1, dans l'état laissé par
+ * les lignes précédentes. Elle :
+ *   - annule F1 s'il existe un F2 avec C|A1| < |A2|/(F2-F1)
+ *   - annule chaque F2 avec C|A2| < |A1|/(F2-F1),
+ *     sauf si la première condition est vraie pour cette paire.
+ *
+ * Les amplitudes à droite de F1 sont dans un arbre (tournoi) qui
+ * donne le maximum "haut" et le minimum "bas" de chaque intervalle.
+ * Pour un intervalle commençant à la distance d de F1 :
+ *   |A2|/(F2-F1) <= haut/d      C|A2| >= C bas
+ * car division et produit flottants sont monotones.
+ * On ne descend donc que dans les intervalles où une condition peut
+ * être vraie. Sur une feuille, ces bornes sont exactement les
+ * comparaisons de la double boucle.
+ *
+ * Les cas particuliers de la double boucle sont gardés :
+ * un A1 nul ne change rien sauf un -0 qui devient +0,
+ * une valeur NaN n'est jamais annulée et n'annule rien.
+ *
+ * Chaque coefficient annulé sort de l'arbre, comme chaque F1 traité.
+ * Sur les spectres de son, une ligne ne visite que quelques
+ * intervalles : O(n log n) par trame au lieu de O(n²).
+ * Le pire cas (construit exprès) reste quadratique.
+ */
+
+struct arbre
+{
+  int p ;			/* Nombre de feuilles (puissance de 2) */
+  float *haut, *bas ;		/* Noeud k : fils 2k et 2k+1 */
+} ;
+
+/* Absent : +0 (rien à annuler), NaN (jamais comparé) ou déjà traité */
+static void feuille(struct arbre *a, int j, float v)
+{
+  a->haut[a->p + j] = ABS(v) > 0 ? ABS(v) : 0 ;
+  a->bas[a->p + j] = ABS(v) > 0 || (v == 0 && signbit(v)) ? fabsf(v)
+    : INFINITY ;
+}
+
+static void remonte(struct arbre *a, int k)
+{
+  a->haut[k] = MAX(a->haut[2*k], a->haut[2*k+1]) ;
+  a->bas[k] = MIN(a->bas[2*k], a->bas[2*k+1]) ;
+}
+
+static void retire(struct arbre *a, int j)
+{
+  int k ;
+
+  feuille(a, j, 0) ;
+  for(k=(a->p + j)/2; k>=1; k/=2)
+    remonte(a, k) ;
+}
+
+/*
+ * Existe-t-il un F2 du noeud "k" (à partir de "debut") masquant F1 ?
+ */
+static int masque(const struct arbre *a, int F1, float ca,
+		  int k, int debut, int taille)
+{
+  int d = MAX(debut - F1, 1) ;
+
+  if ( !(ca < a->haut[k] / d) )
+    return 0 ;
+  if ( k >= a->p )
+    return 1 ;
+  taille /= 2 ;
+  return masque(a, F1, ca, 2*k, debut, taille)
+    || masque(a, F1, ca, 2*k+1, debut + taille, taille) ;
+}
+
+/*
+ * Annule les F2 du noeud "k" masqués par A1.
+ */
+static void annule(struct arbre *a, float *dct, int F1, float A1, float ca,
+		   float c, int k, int debut, int taille)
+{
+  int d = MAX(debut - F1, 1) ;
+
+  if ( !(c * a->bas[k] < ABS(A1) / d) )
+    return ;
+  if ( k >= a->p )
+    {
+      if ( !(ca < a->haut[k] / d) )
+	{
+	  dct[debut] = 0.f ;
+	  feuille(a, debut, 0) ;
+	}
+      return ;
+    }
+  taille /= 2 ;
+  annule(a, dct, F1, A1, ca, c, 2*k, debut, taille) ;
+  annule(a, dct, F1, A1, ca, c, 2*k+1, debut + taille, taille) ;
+  remonte(a, k) ;
+}
+
+void psycho(int nbe, float *dct, float c)
+{
+  struct arene *arene ;
+  Matrice *m ;
+  struct arbre a ;
+  float A1, ca ;
+  int F1, k, masque_F1 ;
+
+  if ( !(c >= 0) )		/* Les bornes supposent C positif */
+    {
+      psycho_paires(nbe, dct, c) ;
+      return ;
+    }
+
+  for(a.p=1; a.p<nbe; a.p*=2)
+    ;
+  arene = arene_session() ;
+  m = arene_matrice(arene, 2, 2*a.p) ;
+  a.haut = m->t[0] ;
+  a.bas = m->t[1] ;
+  feuille(&a, 0, 0) ;		/* La fréquence nulle ne bouge pas */
+  for(F1=1; F1<a.p; F1++)
+    feuille(&a, F1, F1 < nbe ? dct[F1] : 0) ;
+  for(k=a.p-1; k>=1; k--)
+    remonte(&a, k) ;
+
+  for(F1=1; F1<nbe; F1++)
+    {
+      A1 = dct[F1] ;
+      if ( isnan(A1) || (A1 == 0 && !signbit(A1)) )
+	continue ;
+      retire(&a, F1) ;
+      ca = c * ABS(A1) ;
+      masque_F1 = masque(&a, F1, ca, 1, 0, a.p) ;
+      if ( A1 != 0 )
+	annule(&a, dct, F1, A1, ca, c, 1, 0, a.p) ;
+      if ( masque_F1 )
+	dct[F1] = 0.f ;
+    }
+
+  arene_rend(arene, m) ;
+}
+
+/*
+ * Modèle par bandes critiques.
+ *
+ * Le coefficient k de la DCT de nbe échantillons pris à "frequence" Hz
+ * correspond à la fréquence f = k frequence / (2 nbe).
+ * L'échelle des Bark (Zwicker) suit la résolution de l'oreille :
+ *     z(f) = 13 atan(0.00076 f) + 3.5 atan((f/7500)²)
+ * Les coefficients de même partie entière de z forment une bande.
+ *
+ * Pour chaque trame :
+ *   - E(b) : énergie (somme des carrés) de la bande b
+ *   - C = S E : énergie étalée sur les bandes voisines par la
+ *     fonction de Schroeder (en dB, dz = z masquée - z masquante) :
+ *         15.81 + 7.5 (dz + 0.474) - 17.5 sqrt(1 + (dz + 0.474)²)
+ *     et diminuée du décalage de masquage (10 + z/2 dB :
+ *     entre un masque tonal et un bruit).
+ *   - le seuil d'un coefficient de la bande b est le plus grand
+ *     de C(b) / (nombre de coefficients de b) et du seuil absolu
+ *     d'audition (Terhardt, en dB SPL, f en kHz) :
+ *         3.64 f^-0.8 - 6.5 exp(-0.6 (f - 3.3)²) + 0.001 f^4
+ *     Une sinusoïde d'amplitude 128 (les octets du son) est à 90 dB.
+ *
+ * Comme pour "psycho", A est annulé si C * abs(A) < sqrt(seuil).
+ * La matrice S (décalage compris) et les seuils absolus
+ * sont calculés une fois par taille et fréquence.
+ */
+
+#define PLEINE_ECHELLE 90.	/* dB SPL d'une sinusoïde d'amplitude 128 */
+#define BANDES_MAX 26		/* z(f) < 13 pi/2 + 3.5 pi/2 < 26 */
+
+struct bark
+{
+  int nbe, frequence ;
+  int nb_bandes ;
+  int *debut ;			/* nb_bandes+1 : premier coefficient */
+  Matrice *etalement ;		/* nb_bandes x nb_bandes */
+  float *absolu ;		/* Seuil absolu (énergie) par coefficient */
+  struct bark *suivant ;
+} ;
+
+static double bark(double f)
+{
+  return 13 * atan(0.00076 * f) + 3.5 * atan(f * f / (7500. * 7500.)) ;
+}
+
+static double absolu_db(double f)
+{
+  f = MAX(f, 20) / 1000 ;		/* La formule vaut au dessus de 20Hz */
+  return 3.64 * pow(f, -0.8) - 6.5 * exp(-0.6 * (f - 3.3) * (f - 3.3))
+    + 0.001 * pow(f, 4) ;
+}
+
+static double etalement_db(double dz)
+{
+  dz += 0.474 ;
+  return 15.81 + 7.5 * dz - 17.5 * sqrt(1 + dz * dz) ;
+}
+
+static struct bark* open_bark(int nbe, int frequence)
+{
+  struct bark *b ;
+  double pas, z, pleine_echelle ;
+  double centre[BANDES_MAX] ;
+  int k, i, j ;
+
+  ALLOUER(b, 1) ;
+  b->nbe = nbe ;
+  b->frequence = frequence ;
+  ALLOUER(b->debut, nbe + 1) ;
+  ALLOUER(b->absolu, nbe) ;
+  pas = frequence / (2. * nbe) ;
+  pleine_echelle = 128. * 128. * nbe / 2 ;
+
+  b->nb_bandes = 0 ;
+  b->absolu[0] = 0 ;
+  for(k=1; k<nbe; k++)		/* La fréquence nulle n'est pas un son */
+    {
+      if ( k == 1 || (int)bark(k * pas) != (int)bark((k - 1) * pas) )
+	b->debut[b->nb_bandes++] = k ;
+      b->absolu[k] = pleine_echelle
+	* pow(10, (absolu_db(k * pas) - PLEINE_ECHELLE) / 10) ;
+    }
+  b->debut[b->nb_bandes] = nbe ;
+  assert(b->nb_bandes <= BANDES_MAX) ;
+
+  for(i=0; i<b->nb_bandes; i++)
+    centre[i] = bark((b->debut[i] + b->debut[i+1] - 1) / 2. * pas) ;
+  b->etalement = allocation_matrice_float(MAX(b->nb_bandes, 1),
+					   MAX(b->nb_bandes, 1)) ;
+  for(i=0; i<b->nb_bandes; i++)	/* Bande masquée */
+    {
+      z = centre[i] ;
+      for(j=0; j<b->nb_bandes; j++)
+	b->etalement->t[i][j] =
+	  pow(10, (etalement_db(z - centre[j]) - (10 + z / 2)) / 10) ;
+    }
+  b->suivant = NULL ;
+  return b ;
+}
+
+/*
+ * Cache des tables, comme celui des plans de DCT
+ */
+
+static struct bark *barks = NULL ;
+static pthread_mutex_t verrou_barks = PTHREAD_MUTEX_INITIALIZER ;
+
+static const struct bark* cherche_bark(int nbe, int frequence)
+{
+  const struct bark *b ;
+
+  for(b = __atomic_load_n(&barks, __ATOMIC_ACQUIRE); b; b = b->suivant)
+    if ( b->nbe == nbe && b->frequence == frequence )
+      return b ;
+  return NULL ;
+}
+
+static const struct bark* tables_bark(int nbe, int frequence)
+{
+  const struct bark *b ;
+  struct bark *nouveau ;
+
+  b = cherche_bark(nbe, frequence) ;
+  if ( b )
+    return b ;
+
+  pthread_mutex_lock(&verrou_barks) ;
+  b = cherche_bark(nbe, frequence) ;
+  if ( b == NULL )
+    {
+      nouveau = open_bark(nbe, frequence) ;
+      nouveau->suivant = barks ;
+      __atomic_store_n(&barks, nouveau, __ATOMIC_RELEASE) ;
+      b = nouveau ;
+    }
+  pthread_mutex_unlock(&verrou_barks) ;
+  return b ;
+}
+
+static void energies_bark(const struct bark *b, const float *dct,
+			  float *energie)
+{
+  int i, k ;
+
+  for(i=0; i<b->nb_bandes; i++)
+    {
+      energie[i] = 0 ;
+      for(k=b->debut[i]; k<b->debut[i+1]; k++)
+	energie[i] += dct[k] * dct[k] ;
+    }
+}
+
+/*
+ * Annule les coefficients sous le seuil de masquage
+ * de l'énergie "energie" (par bande).
+ */
+static void masque_bark(const struct bark *b, float *dct, float c,
+			const float *energie)
+{
+  float etalee[BANDES_MAX] ;
+  float seuil ;
+  int i, k ;
+
+  produit_matrice_vecteur(b->etalement, energie, etalee) ;
+  for(i=0; i<b->nb_bandes; i++)
+    {
+      seuil = etalee[i] / (b->debut[i+1] - b->debut[i]) ;
+      for(k=b->debut[i]; k<b->debut[i+1]; k++)
+	if ( c * c * dct[k] * dct[k] < MAX(seuil, b->absolu[k]) )
+	  dct[k] = 0.f ;
+    }
+}
+
+void psycho_bark(int nbe, float *dct, float c, int frequence)
+{
+  const struct bark *b ;
+  float energie[BANDES_MAX] ;
+
+  if ( nbe < 2 )
+    return ;
+  b = tables_bark(nbe, frequence) ;
+  energies_bark(b, dct, energie) ;
+  masque_bark(b, dct, c, energie) ;
+}
+
+/*
+ * Masquage temporel : un son fort masque aussi les trames qui le
+ * suivent (post-masquage). Le contexte garde l'énergie masquante de
+ * chaque bande, qui décroît de exp(-T/REMANENCE) par trame de
+ * durée T = nbe / frequence. Une trame est masquée par le plus grand
+ * de sa propre énergie et de cette énergie rémanente.
+ */
+
+#define REMANENCE 0.05		/* Constante de temps en secondes */
+
+struct psycho_temporel
+{
+  const struct bark *tables ;
+  float decroissance ;		/* Par trame */
+  float remanence[BANDES_MAX] ;
+} ;
+
+struct psycho_temporel* open_psycho_temporel(int nbe, int frequence)
+{
+  struct psycho_temporel *p ;
+  int i ;
+
+  assert(nbe >= 2) ;
+  ALLOUER(p, 1) ;
+  p->tables = tables_bark(nbe, frequence) ;
+  p->decroissance = exp(- (double)nbe / frequence / REMANENCE) ;
+  for(i=0; i<BANDES_MAX; i++)
+    p->remanence[i] = 0 ;
+  return p ;
+}
+
+void close_psycho_temporel(struct psycho_temporel *p)
+{
+  free(p) ;
+}
+
+void psycho_temporel(struct psycho_temporel *p, float *dct, float c)
+{
+  float energie[BANDES_MAX] ;
+  int i ;
+
+  energies_bark(p->tables, dct, energie) ;
+  for(i=0; i<p->tables->nb_bandes; i++)
+    {
+      energie[i] = MAX(energie[i], p->decroissance * p->remanence[i]) ;
+      p->remanence[i] = energie[i] ;
+    }
+  masque_bark(p->tables, dct, c, energie) ;
+}
@@ -5,6 +5,30 @@
 #ifndef _HOME_EXCO_REDACTEX_COURS_TRANS_COMP_IMAGE_TP_DCT2_PSYCHO_H
 #define _HOME_EXCO_REDACTEX_COURS_TRANS_COMP_IMAGE_TP_DCT2_PSYCHO_H
 
+/*
+ * Les deux fonctions annulent exactement les mêmes coefficients.
+ * "psycho_paires" compare toutes les paires : O(nbe²).
+ * "psycho" élague les comparaisons inutiles : O(nbe log nbe) en pratique.
+ */
 void psycho(int nbe, float *dct, float c) ;
+void psycho_paires(int nbe, float *dct, float c) ;
+/*
+ * Modèle par bandes critiques (Bark) pour un son échantillonné
+ * à "frequence" Hz : masquage par l'énergie des bandes voisines
+ * et seuil absolu d'audition. La fréquence nulle n'est pas modifiée.
+ * Les tables sont calculées au premier appel pour "nbe" et "frequence".
+ */
+void psycho_bark(int nbe, float *dct, float c, int frequence) ;
+/*
+ * Le modèle Bark avec masquage temporel : les trames successives
+ * d'un même son passent dans l'ordre par le même contexte, qui garde
+ * l'énergie décroissante des bandes des trames précédentes.
+ * Le contexte est de taille fixe, une trame n'alloue rien.
+ */
+struct psycho_temporel ;
+
+struct psycho_temporel* open_psycho_temporel(int nbe, int frequence) ;
+void close_psycho_temporel(struct psycho_temporel *p) ;
+void psycho_temporel(struct psycho_temporel *p, float *dct, float c) ;
 
 #endif
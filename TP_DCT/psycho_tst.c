@@ -1,9 +1,9 @@
 #include "bases.h"
+#include "matrice.h"
+#include "dct.h"
 #include "psycho.h"
 
-void psycho_tst()
-{
-  static float t[] =
+static float t[] =
   {
     10000,
     -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -3, 1, -1, 1,
@@ -14,15 +14,16 @@ void psycho_tst()
     -1, 1, -1, 3, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1,
     -1, 1, -1, 3, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1,
   } ;
-  static float t_ok[] =
+static float t_ok[] =
   { 10000, -1, 1, -1, 1, -1, 1, -1, 1, -1, 0, 0, 0, 0, 0, -3, 0, 0, 0, 10, 0, 0, 0, 3, 0, 0, 0, 0, 0, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 0, 0, 0, 0, 0, -3, 0, 0, 0, -10, 0, 0, 0, 3, 0, 0, 0, 0, 0, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 0, 0, 3, 0, 0, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1 } ;
 
+static int table_tst(void (*f)(int, float*, float))
+{
   float tt[TAILLE(t)] ;
   int i ;
-    
 
   memcpy(tt, t, sizeof(t)) ;
-  psycho(TAILLE(tt), tt, 1) ;
+  (*f)(TAILLE(tt), tt, 1) ;
 
   if ( 0 )
     {
@@ -36,6 +37,178 @@ void psycho_tst()
       {
 	eprintf("Voir le source du test : %s:%d\n", __FILE__, __LINE__) ;
 	eprintf("Index %d, sous trouvez %f au lieu de %f\n", i,tt[i], t_ok[i]);
-	return ;
+	return 1 ;
+      }
+  return 0 ;
+}
+
+/*
+ * "psycho" doit donner les mêmes bits que "psycho_paires"
+ * sur les trames du son, avec quelques valeurs particulières.
+ */
+void psycho_tst()
+{
+  static int tailles[] = { 2, 16, 100, 512 } ;
+  static float qualites[] = { 0, 0.3, 1, 4 } ;
+  unsigned char son[8192] ;
+  float entree[512], attendu[512], obtenu[512] ;
+  FILE *f ;
+  int lu, n, q, nbe, debut, i ;
+
+  if ( table_tst(psycho) )
+    return ;
+
+  f = fopen("DONNEES/spiderman.raw", "r") ;
+  lu = fread(son, 1, sizeof(son), f) ;
+  fclose(f) ;
+
+  for(n=0; n<TAILLE(tailles); n++)
+    for(q=0; q<TAILLE(qualites); q++)
+      {
+	nbe = tailles[n] ;
+	for(debut=0; debut+nbe<=lu; debut+=nbe)
+	  {
+	    for(i=0; i<nbe; i++)
+	      obtenu[i] = son[debut+i] - 128. ;
+	    dct(0, nbe, obtenu, entree) ;
+	    if ( nbe > 8 && debut/nbe % 3 == 1 )
+	      {
+		entree[1] = -0.f ;
+		entree[5] = NAN ;
+		entree[nbe/2] = 0 ;
+		entree[nbe-1] = -0.f ;
+		entree[nbe/3] = INFINITY ;
+	      }
+	    memcpy(attendu, entree, nbe * sizeof(*entree)) ;
+	    memcpy(obtenu, entree, nbe * sizeof(*entree)) ;
+	    psycho_paires(nbe, attendu, qualites[q]) ;
+	    psycho(nbe, obtenu, qualites[q]) ;
+	    if ( memcmp(attendu, obtenu, nbe * sizeof(*obtenu)) )
+	      {
+		for(i=0; memcmp(&attendu[i], &obtenu[i], sizeof(*obtenu));i++)
+		  ;
+		eprintf("nbe=%d qualite=%g trame %d : [%d] = %g au lieu de %g\n"
+			, nbe, qualites[q], debut/nbe, i, obtenu[i], attendu[i]);
+		return ;
+	      }
+	  }
       }
 }
+
+void psycho_paires_tst()
+{
+  table_tst(psycho_paires) ;
+}
+
+/*
+ * Une forte raie masque ses voisines faibles mais pas une raie
+ * moyenne lointaine, les très basses fréquences sont inaudibles
+ * et une qualité plus grande garde plus de coefficients.
+ */
+void psycho_bark_tst()
+{
+  float x[128], y[128] ;
+  unsigned char son[4096] ;
+  FILE *f ;
+  int i, k, lu ;
+
+  for(i=0; i<128; i++)
+    x[i] = 0 ;
+  x[0] = 0.001 ;
+  x[1] = 100 ;			/* 15Hz */
+  x[40] = 5000 ;		/* 625Hz */
+  x[38] = x[41] = 3 ;
+  x[110] = 50 ;			/* 1700Hz */
+  psycho_bark(128, x, 1, 4000) ;
+  if ( x[0] != 0.001f || x[1] != 0 || x[38] != 0 || x[41] != 0
+       || x[40] != 5000 || x[110] != 50 )
+    {
+      eprintf("Mauvais masquage : [0]=%g [1]=%g [38]=%g [40]=%g [41]=%g [110]=%g\n"
+	      , x[0], x[1], x[38], x[40], x[41], x[110]) ;
+      return ;
+    }
+
+  f = fopen("DONNEES/spiderman.raw", "r") ;
+  lu = fread(son, 1, sizeof(son), f) ;
+  fclose(f) ;
+  for(k=0; k+128<=lu; k+=128)
+    {
+      for(i=0; i<128; i++)
+	y[i] = son[k+i] - 128. ;
+      dct(0, 128, y, x) ;
+      memcpy(y, x, sizeof(x)) ;
+      psycho_bark(128, x, 0.5, 4000) ;
+      psycho_bark(128, y, 2, 4000) ;
+      for(i=0; i<128; i++)
+	if ( y[i] == 0 && x[i] != 0 )
+	  {
+	    eprintf("Une qualité plus grande annule [%d] (trame %d)\n"
+		    , i, k/128) ;
+	    return ;
+	  }
+    }
+}
+
+/*
+ * Une trame forte masque la trame faible qui la suit,
+ * l'effet s'efface après quelques trames.
+ */
+void open_psycho_temporel_tst()
+{
+  struct psycho_temporel *p ;
+  float x[128], y[128] ;
+  int i, t ;
+
+  p = open_psycho_temporel(128, 4000) ;
+  for(t=0; t<30; t++)
+    {
+      for(i=0; i<128; i++)
+	x[i] = t == 0 ? 1000 * cos(i) : 10 * cos(i) ;
+      memcpy(y, x, sizeof(x)) ;
+      psycho_temporel(p, x, 1) ;
+      psycho_bark(128, y, 1, 4000) ;
+      if ( (t == 0 || t >= 20) && memcmp(x, y, sizeof(x)) )
+	{
+	  eprintf("Trame %d : le passé ne doit pas (ou plus) compter\n", t) ;
+	  return ;
+	}
+      if ( t == 1 )
+	for(i=1; i<128; i++)
+	  if ( x[i] != 0 )
+	    {
+	      eprintf("Trame %d : [%d] = %g n'est pas masqué\n", t, i, x[i]) ;
+	      return ;
+	    }
+    }
+  close_psycho_temporel(p) ;
+}
+
+void close_psycho_temporel_tst()
+{
+  struct psycho_temporel *p ;
+
+  p = open_psycho_temporel(64, 4000) ;
+  close_psycho_temporel(p) ;
+  if ( open_psycho_temporel(64, 4000) != p )
+    eprintf("Vous êtes sûr de tout libérer ?\n") ;
+}
+
+void psycho_temporel_tst()
+{
+  struct psycho_temporel *p ;
+  float x[256] ;
+  long avant ;
+  int i, t ;
+
+  p = open_psycho_temporel(256, 8000) ;
+  avant = nb_allocations ;
+  for(t=0; t<10; t++)
+    {
+      for(i=0; i<256; i++)
+	x[i] = (t*i*7) % 100 - 50 ;
+      psycho_temporel(p, x, 1) ;
+    }
+  if ( nb_allocations != avant )
+    eprintf("%ld allocations pour 10 trames\n", nb_allocations - avant) ;
+  close_psycho_temporel(p) ;
+}
@@ -1,4 +1,7 @@
 #include "bases.h"
+#include "simd.h"
+#include "bit.h"
+#include "exception.h"
 #include "intstream.h"
 #include "rle.h"
 
@@ -39,25 +42,124 @@
 /*
  * Stocker le tableau de flottant dans les deux "instream"
  * En perdant le moins d'information possible.
+ *
+ * Un coefficient arrondi est non nul si et seulement si
+ * il n'est pas vrai que |x| < 0.5 (un NaN converti en entier
+ * n'est pas nul non plus). Les coefficients sont donc testés
+ * par paquets de 16 en donnant un masque de bits des non nuls,
+ * et on saute d'un non nul au suivant avec "ctz" :
+ * les longues suites de zéros ne coûtent presque rien.
+ * Seuls les non nuls sont arrondis.
+ * Les paires (zéros, valeur) sont écrites par lots.
  */
 
+#define LARGEUR_MASQUE 16
+#define LOT_PAIRES 64
+
+typedef unsigned Masque_non_nuls(const float *dct) ;
+
+static unsigned non_nuls_scalaire(const float *dct)
+{
+  unsigned m ;
+  int i ;
+
+  m = 0 ;
+  for(i=0; i<LARGEUR_MASQUE; i++)
+    if ( !(fabsf(dct[i]) < 0.5f) )
+      m |= 1u << i ;
+  return m ;
+}
+
+#ifdef SIMD_X86
+
+static unsigned non_nuls_sse(const float *dct)
+{
+  const __m128 signe = _mm_set1_ps(-0.f), demi = _mm_set1_ps(0.5f) ;
+  unsigned m ;
+  int i ;
+
+  m = 0 ;
+  for(i=0; i<LARGEUR_MASQUE; i+=4)
+    m |= _mm_movemask_ps(_mm_cmpnlt_ps(_mm_andnot_ps(signe,
+							_mm_loadu_ps(dct + i)),
+					  demi)) << i ;
+  return m ;
+}
+
+CIBLE_AVX2
+static unsigned non_nuls_avx2(const float *dct)
+{
+  const __m256 signe = _mm256_set1_ps(-0.f), demi = _mm256_set1_ps(0.5f) ;
+  __m256 a, b ;
+
+  a = _mm256_andnot_ps(signe, _mm256_loadu_ps(dct)) ;
+  b = _mm256_andnot_ps(signe, _mm256_loadu_ps(dct + 8)) ;
+  return _mm256_movemask_ps(_mm256_cmp_ps(a, demi, _CMP_NLT_UQ))
+    | _mm256_movemask_ps(_mm256_cmp_ps(b, demi, _CMP_NLT_UQ)) << 8 ;
+}
+
+#endif
+
+static Masque_non_nuls *choix_non_nuls()
+{
+  switch(simd_niveau())
+    {
+#ifdef SIMD_X86
+    case Simd_avx2:
+      return non_nuls_avx2 ;
+    case Simd_sse:
+      return non_nuls_sse ;
+#endif
+    default:
+      return non_nuls_scalaire ;
+    }
+}
+
+/*
+ * Masque des non nuls de dct[k] à dct[k+15],
+ * la fin du tableau est complétée par des zéros.
+ */
+static unsigned paquet_non_nuls(Masque_non_nuls *non_nuls
+				, int nbe, const float *dct, int k)
+{
+  float fin[LARGEUR_MASQUE] ;
+
+  if ( k + LARGEUR_MASQUE <= nbe )
+    return (*non_nuls)(dct + k) ;
+  memset(fin, 0, sizeof(fin)) ;
+  memcpy(fin, dct + k, (nbe - k) * sizeof(*dct)) ;
+  return (*non_nuls)(fin) ;
+}
+
 void compresse(struct intstream *entier, struct intstream *entier_signe
 	       , int nbe, const float *dct)
 {
-	unsigned count = 0;
-	int var;
-	for (int k = 0; k < nbe; ++k) {
-		var = roundf(dct[k]);
-		if (var == 0)
-			count++;
-		else {
-			put_entier_intstream(entier, count);
-			put_entier_intstream(entier_signe, var);
-			count = 0;
-		}
+  Masque_non_nuls *non_nuls = choix_non_nuls() ;
+  int nuls[LOT_PAIRES], valeurs[LOT_PAIRES] ;
+  int k, j, n, suivant ;
+  unsigned m ;
+
+  n = 0 ;
+  suivant = 0 ;			/* Après le dernier non nul */
+  for(k=0; k<nbe; k+=LARGEUR_MASQUE)
+    {
+      m = paquet_non_nuls(non_nuls, nbe, dct, k) ;
+      for( ; m ; m &= m - 1)
+	{
+	  j = k + __builtin_ctz(m) ;
+	  nuls[n] = j - suivant ;
+	  valeurs[n] = roundf(dct[j]) ;
+	  suivant = j + 1 ;
+	  if ( ++n == LOT_PAIRES )
+	    {
+	      put_paires_intstream(entier, entier_signe, nuls, valeurs, n) ;
+	      n = 0 ;
+	    }
 	}
-	if(count)
-		put_entier_intstream(entier, count);
+    }
+  put_paires_intstream(entier, entier_signe, nuls, valeurs, n) ;
+  if ( suivant < nbe )
+    put_entier_intstream(entier, nbe - suivant) ;
 }
 
 /*
@@ -80,3 +182,125 @@ void decompresse(struct intstream *entier, struct intstream *entier_signe
 		}		
 	}
 }
+
+/*
+ * Symboles combinés à la JPEG
+ *
+ * Chaque non nul est codé par UN symbole : 16*zéros + taille
+ * où "zéros" est le nombre de nuls qui le précèdent (0 à 15)
+ * et "taille" le nombre de bits de sa valeur absolue (1 à 15).
+ * Le symbole est suivi des "taille" bits bruts de la valeur :
+ * la valeur si elle est positive, sinon valeur + 2^taille - 1
+ * (le bit de poids fort est alors 0).
+ *
+ * Les symboles de taille 0 :
+ *    FIN         (0)   : les coefficients restants sont nuls,
+ *                        il n'est pas écrit si le dernier est non nul.
+ *    SEIZE_ZEROS (240) : 16 zéros, pour les suites plus longues.
+ *    FIN_FLUX    (16)  : il n'y a plus de trame.
+ *    ECHAPPEMENT (32)  : pour une valeur de plus de 15 bits
+ *                        (DC d'une image non quantifiée en NBE=256...),
+ *                        suivi de 4 bits bruts pour les zéros
+ *                        et de 32 bits bruts pour la valeur.
+ *
+ * Le tableau précédent donne :
+ *     (0,3)101 (0,4)1000 (2,3)100 (4,2)10 (0,1)1 FIN
+ * soit 6 symboles au lieu de 11. Seul "symboles" est utilisé,
+ * les bits bruts vont directement dans son "bitstream".
+ */
+
+#define FIN 0
+#define FIN_FLUX 16
+#define SEIZE_ZEROS (15*16)
+#define ECHAPPEMENT (2*16)
+#define TAILLE_MAX 15
+#define BITS_ECHAPPEMENT 32
+
+void compresse_jpeg(struct intstream *symboles, int nbe, const float *dct)
+{
+  Masque_non_nuls *non_nuls = choix_non_nuls() ;
+  int k, j, v, nuls, taille, suivant ;
+  unsigned m, a ;
+
+  suivant = 0 ;
+  for(k=0; k<nbe; k+=LARGEUR_MASQUE)
+    for(m = paquet_non_nuls(non_nuls, nbe, dct, k) ; m ; m &= m - 1)
+      {
+	j = k + __builtin_ctz(m) ;
+	v = roundf(dct[j]) ;
+	a = v < 0 ? -(unsigned)v : v ;
+	taille = nb_bits_utile(a) ;
+	for(nuls = j - suivant; nuls >= 16; nuls -= 16)
+	  put_entier_intstream(symboles, SEIZE_ZEROS) ;
+	if ( taille > TAILLE_MAX )
+	  {
+	    put_entier_intstream(symboles, ECHAPPEMENT) ;
+	    put_bits_intstream(symboles, 4, nuls) ;
+	    put_bits_intstream(symboles, BITS_ECHAPPEMENT, v) ;
+	  }
+	else
+	  {
+	    put_entier_intstream(symboles, 16*nuls + taille) ;
+	    put_bits_intstream(symboles, taille
+			       , v < 0 ? v + (1 << taille) - 1 : v) ;
+	  }
+	suivant = j + 1 ;
+      }
+  if ( suivant < nbe )
+    put_entier_intstream(symboles, FIN) ;
+}
+
+void compresse_jpeg_fin(struct intstream *symboles)
+{
+  put_entier_intstream(symboles, FIN_FLUX) ;
+}
+
+/*
+ * Comme "decompresse".
+ * SEIZE_ZEROS est traité comme 15 zéros suivis d'une valeur nulle.
+ * FIN_FLUX lance "Exception_fichier_lecture" comme la fin du fichier.
+ */
+
+void decompresse_jpeg(struct intstream *symboles, int nbe, float *dct)
+{
+  int k, s, nuls, taille, v ;
+
+  k = 0 ;
+  while( k < nbe )
+    {
+      s = get_entier_intstream(symboles) ;
+      if ( s == FIN )
+	break ;
+      if ( s == FIN_FLUX && k == 0 )
+	EXCEPTION_LANCE(Exception_fichier_lecture) ;
+      if ( s == ECHAPPEMENT )
+	{
+	  nuls = get_bits_intstream(symboles, 4) ;
+	  taille = BITS_ECHAPPEMENT ;
+	}
+      else
+	{
+	  nuls = s / 16 ;
+	  taille = s % 16 ;
+	  if ( s < 0 || s > 255 || (taille == 0 && s != SEIZE_ZEROS) )
+	    EXIT ;
+	}
+      if ( k + nuls >= nbe )
+	EXIT ;
+      for( ; nuls; nuls--)
+	dct[k++] = 0 ;
+      if ( taille == BITS_ECHAPPEMENT )
+	dct[k++] = (int)get_bits_intstream(symboles, BITS_ECHAPPEMENT) ;
+      else if ( taille )
+	{
+	  v = get_bits_intstream(symboles, taille) ;
+	  if ( v < 1 << (taille - 1) )
+	    v -= (1 << taille) - 1 ;
+	  dct[k++] = v ;
+	}
+      else
+	dct[k++] = 0 ;
+    }
+  for( ; k<nbe; k++)
+    dct[k] = 0 ;
+}
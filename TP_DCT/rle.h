@@ -10,5 +10,14 @@ struct intstream ;
 void compresse(struct intstream *entier, struct intstream *entier_signe, int nbe, const float *dct) ;
 void decompresse(struct intstream *entier, struct intstream *entier_signe, int nbe, float *dct) ;
 
+/*
+ * Symboles combinés (zéros, taille) à la JPEG dans un seul "intstream"
+ * avec une fin de bloc. "compresse_jpeg_fin" termine le flux :
+ * "decompresse_jpeg" lance alors "Exception_fichier_lecture".
+ */
+void compresse_jpeg(struct intstream *symboles, int nbe, const float *dct) ;
+void compresse_jpeg_fin(struct intstream *symboles) ;
+void decompresse_jpeg(struct intstream *symboles, int nbe, float *dct) ;
+
 
 #endif
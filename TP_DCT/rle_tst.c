@@ -2,6 +2,8 @@
 #include "rle.h"
 #include "bitstream.h"
 #include "intstream.h"
+#include "simd.h"
+#include "exception.h"
 
 void compresse_test(int nb_t, float *t, int nb_ok, int *ok)
 {
@@ -48,6 +50,102 @@ void compresse_test(int nb_t, float *t, int nb_ok, int *ok)
     }
 }
 
+/*
+ * La boucle d'origine, un coefficient à la fois
+ */
+static void compresse_reference(struct intstream *entier,
+				struct intstream *entier_signe,
+				int nbe, const float *dct)
+{
+  unsigned count = 0 ;
+  int var, k ;
+
+  for(k=0; k<nbe; k++)
+    {
+      var = roundf(dct[k]) ;
+      if ( var == 0 )
+	count++ ;
+      else
+	{
+	  put_entier_intstream(entier, count) ;
+	  put_entier_intstream(entier_signe, var) ;
+	  count = 0 ;
+	}
+    }
+  if ( count )
+    put_entier_intstream(entier, count) ;
+}
+
+static void ecrit(const char *nom, int nb, const float *t,
+		  void (*f)(struct intstream*, struct intstream*,
+			    int, const float*))
+{
+  struct intstream *entier, *entier_signe ;
+  struct bitstream *bs ;
+
+  bs = open_bitstream(nom, "w") ;
+  entier = open_intstream(bs, Entier, NULL) ;
+  entier_signe = open_intstream(bs, Entier_Signe, NULL) ;
+  (*f)(entier, entier_signe, nb, t) ;
+  close_bitstream(bs) ;
+  close_intstream(entier) ;
+  close_intstream(entier_signe) ;
+}
+
+static int memes_octets(const char *nom1, const char *nom2)
+{
+  FILE *f1, *f2 ;
+  int c ;
+
+  f1 = fopen(nom1, "r") ;
+  f2 = fopen(nom2, "r") ;
+  do
+    c = getc(f1) ;
+  while( c == getc(f2) && c != EOF ) ;
+  fclose(f1) ;
+  fclose(f2) ;
+  return c == EOF ;
+}
+
+/*
+ * Chaque niveau SIMD écrit les mêmes bits que la boucle d'origine,
+ * pour toutes les longueurs et les valeurs proches de 0.5
+ */
+static void compresse_simd_tst()
+{
+  static float speciales[] = { 0.5, -0.5, 0.49999997, -0.49999997,
+			       32767, -32767, 32767.49, -32767.49,
+			       32766.5, -32766.5, -0.f, 0.50000006, 3.7,
+			       -1e-30 } ;
+  enum simd_niveau niveau, max ;
+  float t[300] ;
+  int i, nb ;
+
+  max = simd_niveau() ;
+  for(i=0; i<TAILLE(t); i++)
+    t[i] = (i * 7919) % 23 == 0 ? speciales[i % TAILLE(speciales)]
+      : (i / 40) % 2 ? 0.3 * cos(i) : 0 ;
+  for(niveau=Simd_scalaire; niveau<=max; niveau++)
+    {
+      simd_force(niveau) ;
+      for(nb=0; nb<TAILLE(t); nb += nb < 40 ? 1 : 37)
+	{
+	  ecrit("xxx.1", nb, t, compresse_reference) ;
+	  ecrit("xxx.2", nb, t, compresse) ;
+	  if ( !memes_octets("xxx.1", "xxx.2") )
+	    {
+	      eprintf("%s, %d valeurs : pas les bits de la boucle simple\n"
+		      , simd_noms[niveau], nb) ;
+	      simd_force(max) ;
+	      return ;
+	    }
+	}
+    }
+  simd_force(max) ;
+  unlink("xxx.1") ;
+  unlink("xxx.2") ;
+}
+
 void compresse_tst()
 {
   static float t1[] = { 0, 0, 5 } ;
@@ -56,6 +154,8 @@ void compresse_tst()
   static float t2[] = { -0.4, -0.9, 0, 0.4, 0.9, 2    , 0,0,0 } ;
   static int  ok2[] = {      1,-1,          2,1, 0,2,        3 } ;
 
+  compresse_simd_tst() ;
+
   compresse_test(TAILLE(t1), t1, TAILLE(ok1), ok1) ;
   compresse_test(TAILLE(t2), t2, TAILLE(ok2), ok2) ;
 
@@ -101,3 +201,170 @@ void decompresse_tst()
       return ;
     }
 }
+
+/*
+ * Lit les symboles et les bits bruts écrits par "compresse_jpeg".
+ * Dans "ok" chaque symbole est suivi de ses bits s'il en a
+ * (zéros puis valeur pour un échappement).
+ */
+static void compresse_jpeg_test(int nb_t, const float *t, int nb_ok, const int *ok)
+{
+  struct intstream *symboles ;
+  struct bitstream *bs ;
+  int i, s, bits[2], nb_bits[2], n ;
+
+  bs = open_bitstream("xxx.jpeg", "w") ;
+  symboles = open_intstream(bs, Entier, NULL) ;
+  compresse_jpeg(symboles, nb_t, t) ;
+  put_entier_intstream(symboles, 123) ;
+  close_bitstream(bs) ;
+  close_intstream(symboles) ;
+
+  bs = open_bitstream("xxx.jpeg", "r") ;
+  symboles = open_intstream(bs, Entier, NULL) ;
+  for(i=0; i<nb_ok; )
+    {
+      s = get_entier_intstream(symboles) ;
+      if ( s != ok[i] )
+	{
+	  eprintf("[%d] : symbole %d au lieu de %d\n", i, s, ok[i]) ;
+	  break ;
+	}
+      i++ ;
+      nb_bits[0] = s == 32 ? 4 : s % 16 ;
+      nb_bits[1] = s == 32 ? 32 : 0 ;
+      for(n=0; n<2 && nb_bits[n]; n++, i++)
+	{
+	  bits[n] = get_bits_intstream(symboles, nb_bits[n]) ;
+	  if ( i == nb_ok || bits[n] != ok[i] )
+	    {
+	      eprintf("[%d] : bits %d au lieu de %d\n", i, bits[n]
+		      , i < nb_ok ? ok[i] : -1) ;
+	      i = -1 ;
+	      break ;
+	    }
+	}
+      if ( i < 0 )
+	break ;
+    }
+  if ( i == nb_ok && get_entier_intstream(symboles) != 123 )
+    eprintf("Un symbole de trop a été stocké\n") ;
+  close_bitstream(bs) ;
+  close_intstream(symboles) ;
+  unlink("xxx.jpeg") ;
+}
+
+void compresse_jpeg_tst()
+{
+  static float t1[] = { 5, 8, 0, 0, 4, 0, 0, 0, 0, 2, 1, 0, 0, 0 } ;
+  static int  ok1[] = { 3,5, 4,8, 35,4, 66,2, 1,1, 0 } ;
+
+  static float t2[] = { -0.4, -0.9, 0.4, -6.2, 0,0,0,0,0,0,0,0,0,0,
+			0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, -32767 } ;
+  static int  ok2[] = { 17,0, 19,1, 240, 255,0 } ;
+
+  /* Au delà de 15 bits : échappement, 4 bits de zéros, 32 bits */
+  static float t3[] = { 0, 0, 40000, -70000, 32767, 0 } ;
+  static int  ok3[] = { 32,2,40000, 32,0,-70000, 15,32767, 0 } ;
+
+  compresse_jpeg_test(TAILLE(t1), t1, TAILLE(ok1), ok1) ;
+  compresse_jpeg_test(TAILLE(t2), t2, TAILLE(ok2), ok2) ;
+  compresse_jpeg_test(TAILLE(t3), t3, TAILLE(ok3), ok3) ;
+  compresse_jpeg_test(0, t1, 0, ok1) ;
+}
+
+/*
+ * Deux trames puis la fin du flux : la troisième lecture
+ * lance l'exception de fin de fichier.
+ */
+void compresse_jpeg_fin_tst()
+{
+  static float t[] = { 0, 0, 0, 3 } ;
+  struct intstream *symboles ;
+  struct bitstream *bs ;
+  float lu[TAILLE(t)] ;
+  volatile int i ;		/* Garde sa valeur après "longjmp" */
+
+  bs = open_bitstream("xxx.jpeg", "w") ;
+  symboles = open_intstream(bs, Entier, NULL) ;
+  compresse_jpeg(symboles, TAILLE(t), t) ;
+  compresse_jpeg(symboles, 2, t) ;
+  compresse_jpeg_fin(symboles) ;
+  close_bitstream(bs) ;
+  close_intstream(symboles) ;
+
+  bs = open_bitstream("xxx.jpeg", "r") ;
+  symboles = open_intstream(bs, Entier, NULL) ;
+  i = 0 ;
+  EXCEPTION(
+	    for(i=0; i<3; i++)
+	      decompresse_jpeg(symboles, i ? 2 : TAILLE(t), lu) ;
+	    eprintf("La fin du flux n'est pas vue\n") ;
+	    ,
+	    ,
+	    case Exception_fichier_lecture:
+	      if ( i != 2 )
+		eprintf("Fin du flux lue à la trame %d au lieu de 2\n", i) ;
+	      break ;
+	    ) ;
+  close_bitstream(bs) ;
+  close_intstream(symboles) ;
+  unlink("xxx.jpeg") ;
+}
+
+/*
+ * Aller-retour de toutes les longueurs, avec de longues suites
+ * de zéros, à tous les niveaux SIMD.
+ */
+void decompresse_jpeg_tst()
+{
+  enum simd_niveau niveau, max ;
+  struct intstream *symboles ;
+  struct bitstream *bs ;
+  float t[300], lu[TAILLE(t)+1] ;
+  int i, nb ;
+
+  for(i=0; i<TAILLE(t); i++)
+    t[i] = (i / 50) % 2 ? ((i*i*31) % 201 - 100) * 0.3 * (i % 7 == 0 ? 300 : 1)
+      : i % 23 == 0 ? -i * (i % 3 ? 1 : 1000) : 0 ;
+  max = simd_niveau() ;
+  for(niveau=Simd_scalaire; niveau<=max; niveau++)
+    {
+      simd_force(niveau) ;
+      bs = open_bitstream("xxx.jpeg", "w") ;
+      symboles = open_intstream(bs, Entier, NULL) ;
+      for(nb=0; nb<=TAILLE(t); nb++)
+	compresse_jpeg(symboles, nb, t + TAILLE(t) - nb) ;
+      close_bitstream(bs) ;
+      close_intstream(symboles) ;
+
+      bs = open_bitstream("xxx.jpeg", "r") ;
+      symboles = open_intstream(bs, Entier, NULL) ;
+      for(nb=0; nb<=TAILLE(t); nb++)
+	{
+	  lu[nb] = 1234 ;
+	  decompresse_jpeg(symboles, nb, lu) ;
+	  for(i=0; i<nb; i++)
+	    {
+	      if ( lu[i] != roundf(t[TAILLE(t) - nb + i]) )
+		{
+		  eprintf("%s, %d valeurs : [%d] = %g au lieu de %g\n"
+			  , simd_noms[niveau], nb, i, lu[i]
+			  , roundf(t[TAILLE(t) - nb + i])) ;
+		  simd_force(max) ;
+		  return ;
+		}
+	    }
+	  if ( lu[nb] != 1234 )
+	    {
+	      eprintf("%d valeurs : vous avez débordé du tableau\n", nb) ;
+	      simd_force(max) ;
+	      return ;
+	    }
+	}
+      close_bitstream(bs) ;
+      close_intstream(symboles) ;
+    }
+  simd_force(max) ;
+  unlink("xxx.jpeg") ;
+}
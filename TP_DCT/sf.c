@@ -8,10 +8,21 @@
 
 
 #include "bits.h"
+#include "bit.h"
 #include "sf.h"
+#include "exception.h"
 
 #define VALEUR_ESCAPE 0x7fffffff /* Plus grand entier positif */
 
+/*
+ * Au delà de ce total d'occurrences on divise toutes les occurrences
+ * par deux, même si aucun vieillissement n'a été demandé.
+ * Cela évite le débordement des "int" sur les très longs flots.
+ */
+#define LIMITE_OCCURRENCES 0x40000000
+
+static void vieillit(struct shannon_fano *sf) ;
+
 struct evenement
  {
   int valeur ;
@@ -21,6 +32,8 @@ struct evenement
 struct shannon_fano
  {
   int nb_evenements ;
+  int nb_occurrences_total ;	/* Somme des occurrences de la table */
+  int limite_vieillissement ;	/* Total au delà duquel on vieillit */
   struct evenement evenements[200000] ;
  } ;
 
@@ -33,12 +46,53 @@ struct shannon_fano* open_shannon_fano()
   struct shannon_fano* tmp;
   ALLOUER(tmp, 1); 
   tmp->nb_evenements = 1;
+  tmp->nb_occurrences_total = 1;
+  tmp->limite_vieillissement = LIMITE_OCCURRENCES;
   tmp->evenements[0].valeur = VALEUR_ESCAPE;
   tmp->evenements[0].nb_occurrences = 1;
 
   return tmp;
 }
 
+/*
+ * Le vieillissement permet de suivre un flot non stationnaire :
+ * quand le total des occurrences dépasse "limite", toutes les
+ * occurrences sont divisées par deux et les événements tombant
+ * à zéro sont retirés de la table (ESCAPE garde au moins 1).
+ *
+ * Le compresseur et le décompresseur doivent utiliser la même limite.
+ * Une limite nulle ou négative désactive le vieillissement.
+ */
+void sf_vieillissement(struct shannon_fano *sf, int limite)
+{
+  if ( limite <= 0 || limite > LIMITE_OCCURRENCES )
+    limite = LIMITE_OCCURRENCES ;
+  sf->limite_vieillissement = MAX(limite, 2) ;
+  while ( sf->nb_occurrences_total > sf->limite_vieillissement )
+    vieillit(sf) ;
+}
+
+/*
+ * La division par deux conserve l'ordre du tableau.
+ */
+static void vieillit(struct shannon_fano *sf)
+{
+  int i, j = 0;
+
+  sf->nb_occurrences_total = 0;
+  for(i = 0; i < sf->nb_evenements; i++) {
+    struct evenement e = sf->evenements[i];
+    e.nb_occurrences /= 2;
+    if(e.valeur == VALEUR_ESCAPE && e.nb_occurrences == 0)
+      e.nb_occurrences = 1;
+    if(e.nb_occurrences == 0)
+      continue;
+    sf->evenements[j++] = e;
+    sf->nb_occurrences_total += e.nb_occurrences;
+  }
+  sf->nb_evenements = j;
+}
+
 /*
  * Fermeture (libération mémoire)
  */
@@ -91,10 +145,7 @@ static int trouve_separation(const struct shannon_fano *sf
 {
   int min_tot = 0;
   int max_tot = 0;
-  int tot_occ = 0;
-  for(int i = 0; i < sf->nb_evenements; ++i) {
-    tot_occ += sf->evenements[i].nb_occurrences;
-  }
+  int tot_occ = sf->nb_occurrences_total;
 
   for(int i = position_min; i < position_max; ++i) {
     min_tot += sf->evenements[i].nb_occurrences;
@@ -152,9 +203,24 @@ static void incremente_et_ordonne(struct shannon_fano *sf, int position)
   }
   
   sf->evenements[position].nb_occurrences++;
+  sf->nb_occurrences_total++;
   struct evenement temp = sf->evenements[i+1];
   sf->evenements[i+1] = sf->evenements[position];
   sf->evenements[position] = temp;
+
+  if(sf->nb_occurrences_total > sf->limite_vieillissement)
+    vieillit(sf);
+}
+
+/*
+ * Ajoute en fin de table un nouvel événement avec une occurrence.
+ */
+static void ajoute_evenement(struct shannon_fano *sf, int evenement)
+{
+  sf->evenements[sf->nb_evenements].valeur = evenement;
+  sf->evenements[sf->nb_evenements].nb_occurrences = 1;
+  sf->nb_evenements++;
+  sf->nb_occurrences_total++;
 }
 
 /*
@@ -171,13 +237,24 @@ void put_entier_shannon_fano(struct bitstream *bs
   encode_position(bs, sf, pos);
   if(sf->evenements[pos].valeur == VALEUR_ESCAPE){
     put_bits(bs, sizeof(evenement) * 8, evenement);
-    sf->evenements[sf->nb_evenements].valeur = evenement;
-    sf->evenements[sf->nb_evenements].nb_occurrences = 1;
-    sf->nb_evenements++;
+    ajoute_evenement(sf, evenement);
   }
   incremente_et_ordonne(sf,pos);
 }
 
+/*
+ * Comme "put_entier_shannon_fano" mais sans rien écrire :
+ * la table apprend l'événement.
+ * Cela permet de construire une table à partir d'un corpus.
+ */
+void sf_apprend(struct shannon_fano *sf, int evenement)
+{
+  int pos = trouve_position(sf, evenement);
+  if(sf->evenements[pos].valeur == VALEUR_ESCAPE)
+    ajoute_evenement(sf, evenement);
+  incremente_et_ordonne(sf, pos);
+}
+
 /*
  * Fonction inverse de "encode_position"
  */
@@ -211,15 +288,153 @@ int p = decode_position(bs, sf);
   int evenement = sf->evenements[p].valeur;
   if(evenement == VALEUR_ESCAPE) {
     evenement = get_bits(bs, 8 * sizeof(int));
-    sf->evenements[sf->nb_evenements].valeur = evenement;
-    sf->evenements[sf->nb_evenements].nb_occurrences = 1;
-    sf->nb_evenements++;
+    ajoute_evenement(sf, evenement);
   }
 
   incremente_et_ordonne(sf, p);
   return evenement;
 }
 
+/*
+ * Copie de l'état d'un "shannon_fano".
+ * Seule la partie utilisée du tableau des événements est copiée.
+ *
+ * Cela permet par exemple de coder des blocs indépendants
+ * (en parallèle) qui partent tous du même état.
+ */
+struct sf_snapshot
+ {
+  int nb_evenements ;
+  int nb_occurrences_total ;
+  int limite_vieillissement ;
+  struct evenement *evenements ;
+ } ;
+
+struct sf_snapshot* sf_snapshot(const struct shannon_fano *sf)
+{
+  struct sf_snapshot *s;
+
+  ALLOUER(s, 1);
+  ALLOUER(s->evenements, sf->nb_evenements);
+  s->nb_evenements = sf->nb_evenements;
+  s->nb_occurrences_total = sf->nb_occurrences_total;
+  s->limite_vieillissement = sf->limite_vieillissement;
+  memcpy(s->evenements, sf->evenements
+	 , sf->nb_evenements * sizeof(*sf->evenements));
+  return s;
+}
+
+void sf_restore(struct shannon_fano *sf, const struct sf_snapshot *s)
+{
+  sf->nb_evenements = s->nb_evenements;
+  sf->nb_occurrences_total = s->nb_occurrences_total;
+  sf->limite_vieillissement = s->limite_vieillissement;
+  memcpy(sf->evenements, s->evenements
+	 , s->nb_evenements * sizeof(*sf->evenements));
+}
+
+void sf_libere_snapshot(struct sf_snapshot *s)
+{
+  free(s->evenements);
+  free(s);
+}
+
+struct shannon_fano* sf_clone(const struct shannon_fano *sf)
+{
+  struct shannon_fano *tmp;
+
+  ALLOUER(tmp, 1);
+  tmp->nb_evenements = sf->nb_evenements;
+  tmp->nb_occurrences_total = sf->nb_occurrences_total;
+  tmp->limite_vieillissement = sf->limite_vieillissement;
+  memcpy(tmp->evenements, sf->evenements
+	 , sf->nb_evenements * sizeof(*sf->evenements));
+  return tmp;
+}
+
+/*
+ * Sauvegarde compacte d'une table pour amorcer les futurs
+ * "shannon_fano" (voir "open_shannon_fano_fichier").
+ *
+ * Chaque entier est stocké avec son nombre de bits utiles (6 bits)
+ * suivi de ses bits utiles.
+ * Les valeurs sont signées : on les replie sur les naturels
+ * (0 -1 1 -2 2 ... deviennent 0 1 2 3 4 ...).
+ * Les occurrences sont décroissantes dans la table,
+ * on stocke donc la différence avec l'occurrence précédente.
+ */
+
+static void put_naturel(struct bitstream *bs, unsigned int v)
+{
+  unsigned int nb = nb_bits_utile(v);
+  put_bits(bs, 6, nb);
+  put_bits(bs, nb, v);
+}
+
+static unsigned int get_naturel(struct bitstream *bs)
+{
+  return get_bits(bs, get_bits(bs, 6));
+}
+
+void sf_sauve(const struct shannon_fano *sf, const char *fichier)
+{
+  struct bitstream *bs;
+  int i, precedent;
+
+  bs = open_bitstream(fichier, "w");
+  put_naturel(bs, sf->nb_evenements);
+  precedent = sf->evenements[0].nb_occurrences;
+  put_naturel(bs, precedent);
+  for(i = 0; i < sf->nb_evenements; i++) {
+    unsigned int v = sf->evenements[i].valeur;
+    put_naturel(bs, (v << 1) ^ -(v >> 31));
+    put_naturel(bs, precedent - sf->evenements[i].nb_occurrences);
+    precedent = sf->evenements[i].nb_occurrences;
+  }
+  close_bitstream(bs);
+}
+
+static void table_invalide(struct shannon_fano *sf, struct bitstream *bs)
+{
+  close_bitstream(bs);
+  close_shannon_fano(sf);
+  EXCEPTION_LANCE(Exception_arbre_shannon_fano_invalide);
+}
+
+/*
+ * Ouverture d'un "shannon_fano" amorcé avec une table sauvegardée
+ * par "sf_sauve". Le compresseur et le décompresseur doivent
+ * utiliser le même fichier.
+ */
+struct shannon_fano* open_shannon_fano_fichier(const char *fichier)
+{
+  struct shannon_fano *sf;
+  struct bitstream *bs;
+  int i, occurrences;
+
+  sf = open_shannon_fano();
+  bs = open_bitstream(fichier, "r");
+  sf->nb_evenements = get_naturel(bs);
+  if(sf->nb_evenements < 1 || sf->nb_evenements > TAILLE(sf->evenements))
+    table_invalide(sf, bs);
+  occurrences = get_naturel(bs);
+  sf->nb_occurrences_total = 0;
+  for(i = 0; i < sf->nb_evenements; i++) {
+    unsigned int v = get_naturel(bs);
+    sf->evenements[i].valeur = (v >> 1) ^ -(v & 1);
+    occurrences -= get_naturel(bs);
+    if(occurrences < 1)
+      table_invalide(sf, bs);
+    sf->evenements[i].nb_occurrences = occurrences;
+    sf->nb_occurrences_total += occurrences;
+  }
+  if(!sf_table_ok(sf))
+    table_invalide(sf, bs);
+  close_bitstream(bs);
+
+  return sf;
+}
+
 /*
  * Fonctions pour les tests, NE PAS MODIFIER, NE PAS UTILISER.
  */
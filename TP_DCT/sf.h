@@ -10,10 +10,21 @@
 struct shannon_fano ;
 
 struct shannon_fano* open_shannon_fano() ;
+struct shannon_fano* open_shannon_fano_fichier(const char *fichier) ;
 
 void close_shannon_fano(struct shannon_fano *sf) ;
 void put_entier_shannon_fano(struct bitstream *bs, struct shannon_fano *sf, int evenement) ;
 int get_entier_shannon_fano(struct bitstream *bs, struct shannon_fano *sf) ;
+void sf_vieillissement(struct shannon_fano *sf, int limite) ;
+void sf_apprend(struct shannon_fano *sf, int evenement) ;
+void sf_sauve(const struct shannon_fano *sf, const char *fichier) ;
+
+struct sf_snapshot ;
+
+struct shannon_fano* sf_clone(const struct shannon_fano *sf) ;
+struct sf_snapshot* sf_snapshot(const struct shannon_fano *sf) ;
+void sf_restore(struct shannon_fano *sf, const struct sf_snapshot *s) ;
+void sf_libere_snapshot(struct sf_snapshot *s) ; /**/
 
 /* Pour les tests */
 
@@ -285,3 +285,306 @@ void get_entier_shannon_fano_tst()
       close_shannon_fano(sf) ;
     }
 }
+
+void sf_vieillissement_tst()
+{
+  struct shannon_fano *sf ;
+  struct bitstream *bs ;
+  int i, j, valeur, nb_occ, total ;
+
+  /*
+   * Un flot dont l'alphabet change au cours du temps :
+   * les anciens symboles doivent disparaître de la table.
+   */
+  sf = open_shannon_fano() ;
+  sf_vieillissement(sf, 64) ;
+  bs = open_bitstream("xxx", "w") ;
+  for(i=0; i<4000; i++)
+    {
+      put_entier_shannon_fano(bs, sf, (i/500)*10 + i%7) ;
+      if ( ! sf_table_ok(sf) )
+	{
+	  eprintf("La table n'est plus triée après un vieillissement\n") ;
+	  return ;
+	}
+      total = 0 ;
+      for(j=0; j<sf_get_nb_evenements(sf); j++)
+	{
+	  sf_get_evenement(sf, j, &valeur, &nb_occ) ;
+	  if ( nb_occ <= 0 )
+	    {
+	      eprintf("L'événement %d a %d occurrences\n", valeur, nb_occ) ;
+	      return ;
+	    }
+	  total += nb_occ ;
+	}
+      if ( total > 64 )
+	{
+	  eprintf("Le total des occurrences (%d) dépasse la limite\n", total);
+	  return ;
+	}
+    }
+  if ( sf_get_nb_evenements(sf) > 7 + 7 + 1 )
+    {
+      eprintf("Les anciens événements n'ont pas été retirés (%d)\n"
+	      , sf_get_nb_evenements(sf)) ;
+      return ;
+    }
+  close_bitstream(bs) ;
+  close_shannon_fano(sf) ;
+
+  /*
+   * Le décompresseur doit vieillir exactement de la même façon
+   */
+  sf = open_shannon_fano() ;
+  sf_vieillissement(sf, 64) ;
+  bs = open_bitstream("xxx", "r") ;
+  for(i=0; i<4000; i++)
+    {
+      j = get_entier_shannon_fano(bs, sf) ;
+      if ( j != (i/500)*10 + i%7 )
+	{
+	  eprintf("J'attend %d et je reçois %d\n", (i/500)*10 + i%7, j) ;
+	  return ;
+	}
+    }
+  close_bitstream(bs) ;
+  close_shannon_fano(sf) ;
+}
+
+/*
+ * Table apprise sur un petit corpus pour les tests suivants
+ */
+static struct shannon_fano *table_apprise()
+{
+  struct shannon_fano *sf ;
+  int i ;
+
+  sf = open_shannon_fano() ;
+  for(i=0; i<2000; i++)
+    sf_apprend(sf, aleatoire(i)) ;
+  return sf ;
+}
+
+void sf_apprend_tst()
+{
+  struct shannon_fano *sf ;
+  int i, valeur, nb_occ, total ;
+
+  sf = table_apprise() ;
+  if ( ! sf_table_ok(sf) )
+    return ;
+  if ( sf_get_nb_evenements(sf) != 51 )
+    {
+      eprintf("Il y a %d événements au lieu de 51 (50 valeurs et ESCAPE)\n"
+	      , sf_get_nb_evenements(sf)) ;
+      return ;
+    }
+  total = 0 ;
+  for(i=0; i<sf_get_nb_evenements(sf); i++)
+    {
+      sf_get_evenement(sf, i, &valeur, &nb_occ) ;
+      total += nb_occ ;
+    }
+  if ( total != 1 + 50 + 2000 )
+    {
+      eprintf("Le total des occurrences est %d au lieu de %d\n"
+	      , total, 1 + 50 + 2000) ;
+      return ;
+    }
+  close_shannon_fano(sf) ;
+}
+
+void sf_sauve_tst()
+{
+  struct shannon_fano *sf, *sf2 ;
+  int i, valeur, nb_occ, valeur2, nb_occ2 ;
+  FILE *f ;
+
+  sf = table_apprise() ;
+  sf_apprend(sf, -123456789) ;
+  sf_sauve(sf, "xxx") ;
+
+  f = fopen("xxx", "r") ;
+  fseek(f, 0, SEEK_END) ;
+  if ( ftell(f) > 200 )
+    {
+      eprintf("La table sauvegardée n'est pas compacte (%ld octets)\n"
+	      , ftell(f)) ;
+      return ;
+    }
+  fclose(f) ;
+
+  sf2 = open_shannon_fano_fichier("xxx") ;
+  if ( sf_get_nb_evenements(sf) != sf_get_nb_evenements(sf2) )
+    {
+      eprintf("La table relue n'a pas le même nombre d'événements\n") ;
+      return ;
+    }
+  for(i=0; i<sf_get_nb_evenements(sf); i++)
+    {
+      sf_get_evenement(sf, i, &valeur, &nb_occ) ;
+      sf_get_evenement(sf2, i, &valeur2, &nb_occ2) ;
+      if ( valeur != valeur2 || nb_occ != nb_occ2 )
+	{
+	  eprintf("Evénement %d : (%d,%d) relu (%d,%d)\n"
+		  , i, valeur, nb_occ, valeur2, nb_occ2) ;
+	  return ;
+	}
+    }
+  close_shannon_fano(sf) ;
+  close_shannon_fano(sf2) ;
+}
+
+void open_shannon_fano_fichier_tst()
+{
+  struct shannon_fano *sf ;
+  struct bitstream *bs ;
+  FILE *f ;
+  long taille[2] ;
+  int i, j, k ;
+
+  sf = table_apprise() ;
+  sf_sauve(sf, "xxx.modele") ;
+  close_shannon_fano(sf) ;
+
+  /*
+   * Un flot court coûte moins cher avec une table amorcée
+   */
+  for(k=0; k<2; k++)
+    {
+      sf = k ? open_shannon_fano_fichier("xxx.modele") : open_shannon_fano();
+      bs = open_bitstream("xxx", "w") ;
+      for(i=5000; i<5100; i++)
+	put_entier_shannon_fano(bs, sf, aleatoire(i)) ;
+      close_bitstream(bs) ;
+      close_shannon_fano(sf) ;
+      f = fopen("xxx", "r") ;
+      fseek(f, 0, SEEK_END) ;
+      taille[k] = ftell(f) ;
+      fclose(f) ;
+    }
+  if ( taille[1] >= taille[0] )
+    {
+      eprintf("La table amorcée ne réduit pas la taille (%ld >= %ld)\n"
+	      , taille[1], taille[0]) ;
+      return ;
+    }
+
+  sf = open_shannon_fano_fichier("xxx.modele") ;
+  bs = open_bitstream("xxx", "r") ;
+  for(i=5000; i<5100; i++)
+    {
+      j = get_entier_shannon_fano(bs, sf) ;
+      if ( j != aleatoire(i) )
+	{
+	  eprintf("J'attend %d et je reçois %d\n", aleatoire(i), j) ;
+	  return ;
+	}
+    }
+  close_bitstream(bs) ;
+  close_shannon_fano(sf) ;
+  unlink("xxx.modele") ;
+}
+
+static int tables_identiques(struct shannon_fano *a, struct shannon_fano *b)
+{
+  int i, valeur, nb_occ, valeur2, nb_occ2 ;
+
+  if ( sf_get_nb_evenements(a) != sf_get_nb_evenements(b) )
+    return 0 ;
+  for(i=0; i<sf_get_nb_evenements(a); i++)
+    {
+      sf_get_evenement(a, i, &valeur, &nb_occ) ;
+      sf_get_evenement(b, i, &valeur2, &nb_occ2) ;
+      if ( valeur != valeur2 || nb_occ != nb_occ2 )
+	return 0 ;
+    }
+  return 1 ;
+}
+
+void sf_clone_tst()
+{
+  struct shannon_fano *sf, *sf2 ;
+
+  sf = table_apprise() ;
+  sf2 = sf_clone(sf) ;
+  if ( ! tables_identiques(sf, sf2) )
+    {
+      eprintf("Le clone n'a pas la même table que l'original\n") ;
+      return ;
+    }
+  sf_apprend(sf2, 1000) ;
+  if ( sf_get_nb_evenements(sf) != 51 )
+    {
+      eprintf("Modifier le clone modifie l'original\n") ;
+      return ;
+    }
+  close_shannon_fano(sf) ;
+  close_shannon_fano(sf2) ;
+}
+
+void sf_snapshot_tst()
+{
+  struct shannon_fano *sf, *sf2 ;
+  struct sf_snapshot *s ;
+  int i ;
+
+  sf = table_apprise() ;
+  sf2 = sf_clone(sf) ;
+  s = sf_snapshot(sf) ;
+  for(i=0; i<1000; i++)
+    sf_apprend(sf, i % 77) ;
+  sf_restore(sf, s) ;
+  if ( ! tables_identiques(sf, sf2) )
+    {
+      eprintf("sf_restore ne retrouve pas l'état de sf_snapshot\n") ;
+      return ;
+    }
+  sf_libere_snapshot(s) ;
+  close_shannon_fano(sf) ;
+  close_shannon_fano(sf2) ;
+}
+
+/*
+ * Deux blocs codés à partir du même état sont décodables
+ * indépendamment l'un de l'autre.
+ */
+void sf_restore_tst()
+{
+  struct shannon_fano *sf ;
+  struct sf_snapshot *s ;
+  struct bitstream *bs ;
+  static char *noms[] = { "xxx", "xxx.2" } ;
+  int i, j, k ;
+
+  sf = table_apprise() ;
+  s = sf_snapshot(sf) ;
+  for(k=0; k<2; k++)
+    {
+      sf_restore(sf, s) ;
+      bs = open_bitstream(noms[k], "w") ;
+      for(i=0; i<500; i++)
+	put_entier_shannon_fano(bs, sf, aleatoire2(i + 1000*k) + k*100) ;
+      close_bitstream(bs) ;
+    }
+  for(k=1; k>=0; k--)
+    {
+      sf_restore(sf, s) ;
+      bs = open_bitstream(noms[k], "r") ;
+      for(i=0; i<500; i++)
+	{
+	  j = get_entier_shannon_fano(bs, sf) ;
+	  if ( j != aleatoire2(i + 1000*k) + k*100 )
+	    {
+	      eprintf("Bloc %d : j'attend %d et je reçois %d\n"
+		      , k, aleatoire2(i + 1000*k) + k*100, j) ;
+	      return ;
+	    }
+	}
+      close_bitstream(bs) ;
+    }
+  sf_libere_snapshot(s) ;
+  close_shannon_fano(sf) ;
+  unlink("xxx.2") ;
+}
@@ -0,0 +1,46 @@
+#include "bases.h"
+#include "simd.h"
+
+const char *simd_noms[] = { "scalaire", "sse", "avx2" } ;
+
+static int niveau = -1 ;	/* -1 : pas encore déterminé */
+
+static enum simd_niveau niveau_processeur()
+{
+#ifdef SIMD_X86
+  __builtin_cpu_init() ;
+  if ( __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") )
+    return Simd_avx2 ;
+  return Simd_sse ;		/* Toujours présent en x86_64 */
+#else
+  return Simd_scalaire ;
+#endif
+}
+
+/*
+ * Le niveau est calculé complètement avant d'être publié :
+ * les threads du pool qui font le premier appel en même temps
+ * calculent tous la même valeur et ne voient jamais
+ * le niveau du processeur avant la limite de SIMD.
+ */
+enum simd_niveau simd_niveau()
+{
+  int n ;
+
+  n = __atomic_load_n(&niveau, __ATOMIC_ACQUIRE) ;
+  if ( n < 0 )
+    {
+      n = niveau_processeur() ;
+      if ( getenv("SIMD") && atoi(getenv("SIMD")) < n )
+	n = MAX(atoi(getenv("SIMD")), Simd_scalaire) ;
+      __atomic_store_n(&niveau, n, __ATOMIC_RELEASE) ;
+    }
+  return n ;
+}
+
+void simd_force(enum simd_niveau n)
+{
+  enum simd_niveau max = niveau_processeur() ;
+
+  __atomic_store_n(&niveau, n < max ? n : max, __ATOMIC_RELEASE) ;
+}
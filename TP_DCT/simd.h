@@ -0,0 +1,42 @@
+/*
+ * Choix à l'exécution des noyaux de calcul vectoriels.
+ */
+
+#ifndef SIMD_H
+#define SIMD_H
+
+/*
+ * Les niveaux sont ordonnés : un processeur AVX2 sait faire du SSE.
+ */
+enum simd_niveau
+{  Simd_scalaire
+  ,Simd_sse
+  ,Simd_avx2
+} ;
+
+#if defined(__x86_64__)
+#define SIMD_X86 1
+#include <immintrin.h>
+/*
+ * Les fonctions AVX2 sont compilées avec cet attribut,
+ * le reste du programme reste compilable sans "-mavx2".
+ */
+#define CIBLE_AVX2 __attribute__((target("avx2,fma")))
+/*
+ * AVX sans FMA : les additions et multiplications ne sont pas
+ * fusionnées, les résultats sont identiques bit à bit au SSE.
+ */
+#define CIBLE_AVX __attribute__((target("avx")))
+#endif
+
+/*
+ * Le niveau utilisable : celui du processeur, limité par
+ * la variable d'environnement SIMD (0=scalaire, 1=SSE, 2=AVX2)
+ * ou par "simd_force".
+ */
+enum simd_niveau simd_niveau() ;
+void simd_force(enum simd_niveau niveau) ;
+
+extern const char *simd_noms[] ;
+
+#endif
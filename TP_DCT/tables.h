@@ -0,0 +1,445 @@
+/* Généré par : tables_genere 8 16 32 */
+
+static const float dct_8[64] __attribute__((aligned(64))) =
+  {
+    0.35355339059327373, 0.35355339059327373, 0.35355339059327373, 0.35355339059327373,
+    0.35355339059327373, 0.35355339059327373, 0.35355339059327373, 0.35355339059327373,
+    0.49039264020161522, 0.41573480615127262, 0.27778511650980114, 0.097545161008064166,
+    -0.097545161008064096, -0.27778511650980098, -0.41573480615127267, -0.49039264020161522,
+    0.46193976625564337, 0.19134171618254492, -0.19134171618254486, -0.46193976625564337,
+    -0.46193976625564342, -0.19134171618254517, 0.191341716182545, 0.46193976625564326,
+    0.41573480615127262, -0.097545161008064096, -0.49039264020161522, -0.27778511650980109,
+    0.27778511650980092, 0.49039264020161522, 0.097545161008064388, -0.41573480615127256,
+    0.35355339059327379, -0.35355339059327373, -0.35355339059327384, 0.35355339059327368,
+    0.35355339059327384, -0.35355339059327334, -0.35355339059327356, 0.35355339059327329,
+    0.27778511650980114, -0.49039264020161522, 0.097545161008064152, 0.41573480615127273,
+    -0.41573480615127256, -0.097545161008064013, 0.49039264020161533, -0.27778511650980076,
+    0.19134171618254492, -0.46193976625564342, 0.46193976625564326, -0.19134171618254495,
+    -0.19134171618254528, 0.46193976625564337, -0.4619397662556432, 0.19134171618254478,
+    0.097545161008064166, -0.27778511650980109, 0.41573480615127273, -0.49039264020161533,
+    0.49039264020161522, -0.41573480615127251, 0.27778511650980076, -0.097545161008064291,
+  } ;
+
+static const short zigzag_8[64] =
+  {
+    0, 1, 8, 16, 9, 2, 3, 10, 17, 24, 32, 25, 18, 11, 4, 5,
+    12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13, 6, 7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63,
+  } ;
+
+static const float dct_16[256] __attribute__((aligned(64))) =
+  {
+    0.25, 0.25, 0.25, 0.25,
+    0.25, 0.25, 0.25, 0.25,
+    0.25, 0.25, 0.25, 0.25,
+    0.25, 0.25, 0.25, 0.25,
+    0.35185093438159565, 0.33832950029358816, 0.31180625324666783, 0.2733004667504394,
+    0.2242918965856591, 0.16666391461943669, 0.10263113188058934, 0.034654292299772925,
+    -0.034654292299772883, -0.10263113188058928, -0.16666391461943666, -0.22429189658565904,
+    -0.2733004667504394, -0.31180625324666777, -0.33832950029358816, -0.35185093438159559,
+    0.34675996133053688, 0.29396890060483971, 0.19642373959677559, 0.068974844820735778,
+    -0.068974844820735737, -0.19642373959677548, -0.29396890060483971, -0.34675996133053688,
+    -0.34675996133053688, -0.29396890060483977, -0.19642373959677553, -0.068974844820735903,
+    0.068974844820735765, 0.19642373959677542, 0.29396890060483971, 0.34675996133053683,
+    0.33832950029358816, 0.2242918965856591, 0.034654292299772925, -0.16666391461943666,
+    -0.31180625324666777, -0.35185093438159565, -0.27330046675043945, -0.10263113188058938,
+    0.10263113188058924, 0.27330046675043929, 0.35185093438159565, 0.31180625324666783,
+    0.16666391461943675, -0.03465429229977264, -0.22429189658565885, -0.33832950029358805,
+    0.32664074121909414, 0.13529902503654928, -0.13529902503654925, -0.32664074121909414,
+    -0.3266407412190942, -0.13529902503654945, 0.13529902503654934, 0.32664074121909409,
+    0.32664074121909414, 0.1352990250365495, -0.13529902503654931, -0.32664074121909403,
+    -0.32664074121909414, -0.13529902503654953, 0.13529902503654925, 0.32664074121909403,
+    0.31180625324666783, 0.034654292299772925, -0.2733004667504394, -0.33832950029358821,
+    -0.10263113188058938, 0.22429189658565912, 0.35185093438159565, 0.16666391461943675,
+    -0.16666391461943658, -0.35185093438159565, -0.22429189658565904, 0.10263113188058946,
+    0.33832950029358805, 0.27330046675043962, -0.034654292299772557, -0.31180625324666772,
+    0.29396890060483971, -0.068974844820735737, -0.34675996133053688, -0.19642373959677553,
+    0.19642373959677542, 0.34675996133053688, 0.068974844820735931, -0.29396890060483966,
+    -0.29396890060483982, 0.068974844820735376, 0.34675996133053688, 0.19642373959677567,
+    -0.19642373959677531, -0.34675996133053694, -0.068974844820736375, 0.29396890060483927,
+    0.2733004667504394, -0.16666391461943666, -0.33832950029358821, 0.034654292299772689,
+    0.35185093438159565, 0.10263113188058942, -0.31180625324666777, -0.22429189658565904,
+    0.22429189658565882, 0.31180625324666794, -0.10263113188058942, -0.35185093438159565,
+    -0.034654292299773612, 0.33832950029358821, 0.16666391461943691, -0.27330046675043895,
+    0.25000000000000006, -0.25, -0.25000000000000006, 0.24999999999999994,
+    0.25000000000000006, -0.24999999999999972, -0.24999999999999989, 0.24999999999999969,
+    0.24999999999999992, -0.24999999999999964, -0.24999999999999994, 0.24999999999999961,
+    0.25, -0.24999999999999961, -0.25000000000000006, 0.24999999999999956,
+    0.2242918965856591, -0.31180625324666777, -0.10263113188058938, 0.35185093438159565,
+    -0.03465429229977264, -0.33832950029358816, 0.16666391461943653, 0.27330046675043962,
+    -0.2733004667504394, -0.16666391461943686, 0.33832950029358821, 0.034654292299773654,
+    -0.3518509343815957, 0.1026311318805893, 0.31180625324666827, -0.22429189658565865,
+    0.19642373959677559, -0.34675996133053688, 0.068974844820735765, 0.29396890060483977,
+    -0.29396890060483966, -0.068974844820735667, 0.34675996133053694, -0.19642373959677531,
+    -0.1964237395967757, 0.34675996133053688, -0.068974844820735862, -0.2939689006048396,
+    0.29396890060483921, 0.0689748448207365, -0.34675996133053699, 0.19642373959677514,
+    0.16666391461943669, -0.35185093438159565, 0.22429189658565912, 0.10263113188058942,
+    -0.33832950029358816, 0.2733004667504394, 0.034654292299772939, -0.31180625324666822,
+    0.311806253246668, -0.034654292299773092, -0.27330046675043934, 0.33832950029358816,
+    -0.10263113188058925, -0.22429189658565923, 0.35185093438159559, -0.16666391461943517,
+    0.13529902503654928, -0.3266407412190942, 0.32664074121909409, -0.13529902503654931,
+    -0.13529902503654953, 0.32664074121909414, -0.32664074121909403, 0.13529902503654917,
+    0.13529902503654964, -0.32664074121909448, 0.3266407412190942, -0.13529902503654906,
+    -0.13529902503654978, 0.32664074121909448, -0.3266407412190937, 0.13529902503654775,
+    0.10263113188058934, -0.27330046675043945, 0.35185093438159565, -0.31180625324666777,
+    0.16666391461943653, 0.034654292299772939, -0.22429189658565912, 0.33832950029358838,
+    -0.33832950029358821, 0.22429189658565868, -0.034654292299773008, -0.16666391461943703,
+    0.31180625324666833, -0.35185093438159559, 0.27330046675043879, -0.10263113188058788,
+    0.068974844820735778, -0.19642373959677553, 0.29396890060483977, -0.34675996133053694,
+    0.34675996133053688, -0.2939689006048396, 0.19642373959677531, -0.068974844820735862,
+    -0.068974844820736458, 0.19642373959677578, -0.2939689006048396, 0.34675996133053705,
+    -0.3467599613305366, 0.29396890060483982, -0.19642373959677503, 0.068974844820734335,
+    0.034654292299772925, -0.10263113188058938, 0.16666391461943675, -0.22429189658565904,
+    0.27330046675043962, -0.31180625324666822, 0.33832950029358838, -0.3518509343815957,
+    0.35185093438159559, -0.33832950029358816, 0.31180625324666794, -0.27330046675043962,
+    0.22429189658565854, -0.16666391461943508, 0.10263113188058905, -0.034654292299771502,
+  } ;
+
+static const short zigzag_16[256] =
+  {
+    0, 1, 16, 32, 17, 2, 3, 18, 33, 48, 64, 49, 34, 19, 4, 5,
+    20, 35, 50, 65, 80, 96, 81, 66, 51, 36, 21, 6, 7, 22, 37, 52,
+    67, 82, 97, 112, 128, 113, 98, 83, 68, 53, 38, 23, 8, 9, 24, 39,
+    54, 69, 84, 99, 114, 129, 144, 160, 145, 130, 115, 100, 85, 70, 55, 40,
+    25, 10, 11, 26, 41, 56, 71, 86, 101, 116, 131, 146, 161, 176, 192, 177,
+    162, 147, 132, 117, 102, 87, 72, 57, 42, 27, 12, 13, 28, 43, 58, 73,
+    88, 103, 118, 133, 148, 163, 178, 193, 208, 224, 209, 194, 179, 164, 149, 134,
+    119, 104, 89, 74, 59, 44, 29, 14, 15, 30, 45, 60, 75, 90, 105, 120,
+    135, 150, 165, 180, 195, 210, 225, 240, 241, 226, 211, 196, 181, 166, 151, 136,
+    121, 106, 91, 76, 61, 46, 31, 47, 62, 77, 92, 107, 122, 137, 152, 167,
+    182, 197, 212, 227, 242, 243, 228, 213, 198, 183, 168, 153, 138, 123, 108, 93,
+    78, 63, 79, 94, 109, 124, 139, 154, 169, 184, 199, 214, 229, 244, 245, 230,
+    215, 200, 185, 170, 155, 140, 125, 110, 95, 111, 126, 141, 156, 171, 186, 201,
+    216, 231, 246, 247, 232, 217, 202, 187, 172, 157, 142, 127, 143, 158, 173, 188,
+    203, 218, 233, 248, 249, 234, 219, 204, 189, 174, 159, 175, 190, 205, 220, 235,
+    250, 251, 236, 221, 206, 191, 207, 222, 237, 252, 253, 238, 223, 239, 254, 255,
+  } ;
+
+static const float dct_32[1024] __attribute__((aligned(64))) =
+  {
+    0.17677669529663687, 0.17677669529663687, 0.17677669529663687, 0.17677669529663687,
+    0.17677669529663687, 0.17677669529663687, 0.17677669529663687, 0.17677669529663687,
+    0.17677669529663687, 0.17677669529663687, 0.17677669529663687, 0.17677669529663687,
+    0.17677669529663687, 0.17677669529663687, 0.17677669529663687, 0.17677669529663687,
+    0.17677669529663687, 0.17677669529663687, 0.17677669529663687, 0.17677669529663687,
+    0.17677669529663687, 0.17677669529663687, 0.17677669529663687, 0.17677669529663687,
+    0.17677669529663687, 0.17677669529663687, 0.17677669529663687, 0.17677669529663687,
+    0.17677669529663687, 0.17677669529663687, 0.17677669529663687, 0.17677669529663687,
+    0.2496988640512931, 0.24729412749119525, 0.24250781329863599, 0.2353860162957552,
+    0.22599732328086083, 0.21443215250006803, 0.20080188287016124, 0.18523778133873978,
+    0.16788973871175458, 0.14892482612310837, 0.12852568604830542, 0.10688877335757055,
+    0.084222463348055013, 0.060745044975815995, 0.036682618613840437, 0.012266918581854531,
+    -0.012266918581854502, -0.036682618613840409, -0.060745044975815968, -0.084222463348054985,
+    -0.10688877335757047, -0.12852568604830542, -0.14892482612310834, -0.16788973871175461,
+    -0.18523778133873972, -0.20080188287016121, -0.214432152500068, -0.22599732328086083,
+    -0.23538601629575517, -0.24250781329863599, -0.24729412749119525, -0.2496988640512931,
+    0.24879618166804923, 0.23923508393305221, 0.22048031608708876, 0.19325261334068425,
+    0.15859832104091137, 0.11784918420649945, 0.072571169313615583, 0.024504285082390193,
+    -0.024504285082390161, -0.072571169313615541, -0.11784918420649942, -0.15859832104091134,
+    -0.19325261334068425, -0.22048031608708873, -0.23923508393305221, -0.2487961816680492,
+    -0.24879618166804923, -0.23923508393305223, -0.22048031608708876, -0.19325261334068428,
+    -0.15859832104091148, -0.11784918420649947, -0.072571169313615611, -0.024504285082390113,
+    0.024504285082390023, 0.072571169313615513, 0.1178491842064994, 0.1585983210409114,
+    0.19325261334068417, 0.22048031608708871, 0.23923508393305221, 0.24879618166804923,
+    0.24729412749119525, 0.22599732328086083, 0.18523778133873978, 0.12852568604830542,
+    0.060745044975815995, -0.012266918581854502, -0.084222463348054985, -0.14892482612310834,
+    -0.20080188287016121, -0.23538601629575517, -0.2496988640512931, -0.24250781329863599,
+    -0.21443215250006803, -0.16788973871175467, -0.10688877335757062, -0.036682618613840576,
+    0.036682618613840486, 0.10688877335757054, 0.16788973871175458, 0.214432152500068,
+    0.24250781329863599, 0.2496988640512931, 0.23538601629575523, 0.20080188287016132,
+    0.14892482612310831, 0.084222463348055013, 0.012266918581854538, -0.060745044975815697,
+    -0.12852568604830536, -0.18523778133873983, -0.22599732328086078, -0.24729412749119525,
+    0.24519632010080761, 0.20786740307563631, 0.13889255825490057, 0.048772580504032083,
+    -0.048772580504032048, -0.13889255825490049, -0.20786740307563634, -0.24519632010080761,
+    -0.24519632010080761, -0.20786740307563636, -0.13889255825490054, -0.048772580504032166,
+    0.048772580504032076, 0.13889255825490046, 0.20786740307563631, 0.24519632010080758,
+    0.24519632010080761, 0.20786740307563636, 0.13889255825490057, 0.048772580504032194,
+    -0.048772580504031826, -0.13889255825490043, -0.20786740307563628, -0.24519632010080764,
+    -0.24519632010080766, -0.20786740307563639, -0.1388925582549006, -0.048772580504032007,
+    0.048772580504031798, 0.13889255825490041, 0.20786740307563628, 0.24519632010080761,
+    0.24250781329863599, 0.18523778133873978, 0.084222463348055013, -0.036682618613840409,
+    -0.14892482612310834, -0.22599732328086083, -0.2496988640512931, -0.21443215250006803,
+    -0.12852568604830544, -0.012266918581854507, 0.10688877335757054, 0.20080188287016126,
+    0.24729412749119523, 0.23538601629575523, 0.16788973871175469, 0.060745044975816058,
+    -0.060745044975815697, -0.16788973871175442, -0.23538601629575512, -0.24729412749119528,
+    -0.20080188287016135, -0.10688877335757067, 0.012266918581854355, 0.12852568604830533,
+    0.21443215250006797, 0.2496988640512931, 0.22599732328086086, 0.14892482612310837,
+    0.036682618613840451, -0.084222463348055027, -0.1852377813387398, -0.24250781329863602,
+    0.23923508393305221, 0.15859832104091137, 0.024504285082390193, -0.11784918420649942,
+    -0.22048031608708873, -0.24879618166804923, -0.19325261334068428, -0.072571169313615611,
+    0.072571169313615513, 0.19325261334068417, 0.24879618166804923, 0.22048031608708876,
+    0.11784918420649949, -0.024504285082389991, -0.15859832104091121, -0.23923508393305212,
+    -0.23923508393305218, -0.15859832104091134, -0.024504285082390172, 0.11784918420649934,
+    0.22048031608708868, 0.24879618166804923, 0.19325261334068441, 0.072571169313615902,
+    -0.072571169313615638, -0.19325261334068425, -0.2487961816680492, -0.22048031608708904,
+    -0.11784918420649958, 0.024504285082390342, 0.15859832104091112, 0.23923508393305223,
+    0.2353860162957552, 0.12852568604830542, -0.036682618613840409, -0.18523778133873972,
+    -0.2496988640512931, -0.20080188287016124, -0.06074504497581603, 0.10688877335757054,
+    0.22599732328086078, 0.24250781329863602, 0.14892482612310831, -0.012266918581854386,
+    -0.16788973871175442, -0.24729412749119525, -0.21443215250006809, -0.084222463348055249,
+    0.084222463348055054, 0.21443215250006797, 0.24729412749119528, 0.16788973871175455,
+    0.012266918581854599, -0.14892482612310814, -0.24250781329863602, -0.22599732328086086,
+    -0.10688877335757033, 0.060745044975815607, 0.20080188287016118, 0.2496988640512931,
+    0.18523778133874003, 0.036682618613840506, -0.12852568604830564, -0.23538601629575506,
+    0.23096988312782168, 0.095670858091272459, -0.095670858091272432, -0.23096988312782168,
+    -0.23096988312782171, -0.095670858091272584, 0.095670858091272501, 0.23096988312782163,
+    0.23096988312782168, 0.095670858091272612, -0.095670858091272473, -0.2309698831278216,
+    -0.23096988312782168, -0.09567085809127264, 0.095670858091272445, 0.2309698831278216,
+    0.23096988312782168, 0.095670858091272667, -0.095670858091272418, -0.2309698831278216,
+    -0.23096988312782188, -0.095670858091272695, 0.09567085809127239, 0.23096988312782174,
+    0.23096988312782188, 0.095670858091272723, -0.095670858091272362, -0.23096988312782174,
+    -0.23096988312782191, -0.095670858091272751, 0.095670858091272334, 0.23096988312782171,
+    0.22599732328086083, 0.060745044975815995, -0.14892482612310834, -0.2496988640512931,
+    -0.16788973871175467, 0.036682618613840486, 0.214432152500068, 0.23538601629575523,
+    0.084222463348055013, -0.12852568604830536, -0.24729412749119525, -0.18523778133873997,
+    0.012266918581854355, 0.20080188287016121, 0.24250781329863608, 0.1068887733575707,
+    -0.10688877335757045, -0.24250781329863602, -0.20080188287016137, -0.01226691858185463,
+    0.18523778133873978, 0.24729412749119523, 0.12852568604830597, -0.084222463348054541,
+    -0.23538601629575506, -0.21443215250006814, -0.036682618613840541, 0.16788973871175461,
+    0.2496988640512931, 0.14892482612310881, -0.060745044975815517, -0.2259973232808607,
+    0.22048031608708876, 0.024504285082390193, -0.19325261334068425, -0.23923508393305223,
+    -0.072571169313615611, 0.1585983210409114, 0.24879618166804923, 0.11784918420649949,
+    -0.11784918420649937, -0.24879618166804923, -0.15859832104091134, 0.072571169313615666,
+    0.23923508393305212, 0.19325261334068441, -0.024504285082389929, -0.22048031608708868,
+    -0.22048031608708904, -0.024504285082390675, 0.19325261334068394, 0.23923508393305234,
+    0.072571169313615971, -0.15859832104091109, -0.24879618166804926, -0.11784918420649963,
+    0.11784918420649923, 0.2487961816680492, 0.15859832104091146, -0.072571169313615527,
+    -0.23923508393305221, -0.19325261334068422, 0.02450428508239022, 0.22048031608708882,
+    0.21443215250006803, -0.012266918581854502, -0.22599732328086083, -0.20080188287016124,
+    0.036682618613840486, 0.2353860162957552, 0.1852377813387398, -0.060745044975815697,
+    -0.24250781329863602, -0.16788973871175453, 0.084222463348055054, 0.24729412749119525,
+    0.14892482612310837, -0.10688877335757045, -0.2496988640512931, -0.12852568604830594,
+    0.12852568604830567, 0.2496988640512931, 0.10688877335757035, -0.14892482612310845,
+    -0.24729412749119523, -0.084222463348054957, 0.16788973871175461, 0.24250781329863599,
+    0.060745044975816023, -0.18523778133873972, -0.23538601629575523, -0.036682618613840604,
+    0.2008018828701611, 0.22599732328086095, 0.012266918581855669, -0.21443215250006739,
+    0.20786740307563631, -0.048772580504032048, -0.24519632010080761, -0.13889255825490054,
+    0.13889255825490046, 0.24519632010080761, 0.048772580504032194, -0.20786740307563628,
+    -0.20786740307563639, 0.048772580504031798, 0.24519632010080761, 0.13889255825490063,
+    -0.13889255825490038, -0.24519632010080766, -0.048772580504032499, 0.207867403075636,
+    0.2078674030756362, -0.048772580504032145, -0.24519632010080761, -0.13889255825490068,
+    0.13889255825490032, 0.24519632010080769, 0.048772580504032589, -0.20786740307563595,
+    -0.20786740307563625, 0.048772580504032055, 0.24519632010080758, 0.13889255825490152,
+    -0.13889255825490024, -0.24519632010080752, -0.04877258050403268, 0.20786740307563639,
+    0.20080188287016124, -0.084222463348054985, -0.2496988640512931, -0.06074504497581603,
+    0.214432152500068, 0.1852377813387398, -0.10688877335757051, -0.24729412749119528,
+    -0.036682618613840416, 0.22599732328086075, 0.16788973871175455, -0.1285256860483053,
+    -0.24250781329863608, -0.01226691858185463, 0.23538601629575509, 0.14892482612310876,
+    -0.14892482612310845, -0.23538601629575523, 0.012266918581854231, 0.24250781329863588,
+    0.12852568604830603, -0.16788973871175461, -0.22599732328086092, 0.036682618613840028,
+    0.24729412749119514, 0.10688877335757127, -0.18523778133873908, -0.21443215250006775,
+    0.060745044975816287, 0.2496988640512931, 0.084222463348055096, -0.20080188287016104,
+    0.19325261334068425, -0.11784918420649942, -0.23923508393305223, 0.024504285082390023,
+    0.24879618166804923, 0.072571169313615638, -0.22048031608708871, -0.15859832104091134,
+    0.15859832104091118, 0.22048031608708882, -0.072571169313615638, -0.24879618166804923,
+    -0.024504285082390675, 0.23923508393305223, 0.1178491842064996, -0.19325261334068392,
+    -0.19325261334068419, 0.11784918420649923, 0.23923508393305237, -0.024504285082390248,
+    -0.2487961816680492, -0.072571169313616055, 0.22048031608708882, 0.15859832104091151,
+    -0.15859832104091171, -0.22048031608708912, 0.072571169313615444, 0.24879618166804918,
+    0.02450428508239089, -0.23923508393305218, -0.11784918420649901, 0.19325261334068378,
+    0.18523778133873978, -0.14892482612310834, -0.21443215250006803, 0.10688877335757054,
+    0.23538601629575523, -0.060745044975815697, -0.24729412749119528, 0.012266918581854355,
+    0.2496988640512931, 0.036682618613840451, -0.24250781329863602, -0.084222463348054888,
+    0.22599732328086072, 0.12852568604830597, -0.20080188287016115, -0.16788973871175497,
+    0.16788973871175461, 0.20080188287016143, -0.12852568604830558, -0.22599732328086092,
+    0.084222463348054458, 0.24250781329863602, -0.036682618613840874, -0.2496988640512931,
+    -0.012266918581854813, 0.24729412749119514, 0.060745044975817002, -0.23538601629575531,
+    -0.10688877335757055, 0.21443215250006781, 0.14892482612310898, -0.185237781338739,
+    0.17677669529663689, -0.17677669529663687, -0.17677669529663692, 0.17677669529663684,
+    0.17677669529663692, -0.17677669529663667, -0.17677669529663678, 0.17677669529663664,
+    0.17677669529663681, -0.17677669529663662, -0.17677669529663684, 0.17677669529663659,
+    0.17677669529663687, -0.17677669529663659, -0.17677669529663689, 0.17677669529663656,
+    0.17677669529663689, -0.17677669529663653, -0.17677669529663692, 0.1767766952966365,
+    0.17677669529663759, -0.1767766952966365, -0.17677669529663698, 0.17677669529663709,
+    0.17677669529663761, -0.17677669529663645, -0.176776695296637, 0.17677669529663706,
+    0.17677669529663767, -0.17677669529663639, -0.17677669529663706, 0.176776695296637,
+    0.16788973871175458, -0.20080188287016121, -0.12852568604830544, 0.22599732328086078,
+    0.084222463348055013, -0.24250781329863602, -0.036682618613840416, 0.2496988640512931,
+    -0.012266918581854323, -0.24729412749119528, 0.060745044975815607, 0.2353860162957552,
+    -0.10688877335757001, -0.21443215250006814, 0.14892482612310842, 0.18523778133874005,
+    -0.18523778133873972, -0.14892482612310884, 0.21443215250006786, 0.10688877335757127,
+    -0.23538601629575534, -0.060745044975816107, 0.24729412749119514, 0.01226691858185573,
+    -0.2496988640512931, 0.036682618613839903, 0.24250781329863627, -0.084222463348055152,
+    -0.225997323280861, 0.12852568604830464, 0.20080188287016104, -0.16788973871175442,
+    0.15859832104091137, -0.22048031608708873, -0.072571169313615611, 0.24879618166804923,
+    -0.024504285082389991, -0.23923508393305218, 0.11784918420649934, 0.19325261334068441,
+    -0.19325261334068425, -0.11784918420649958, 0.23923508393305223, 0.024504285082390706,
+    -0.24879618166804926, 0.072571169313615555, 0.22048031608708907, -0.15859832104091107,
+    -0.15859832104091148, 0.22048031608708882, 0.072571169313616082, -0.2487961816680492,
+    0.024504285082390158, 0.23923508393305215, -0.11784918420649831, -0.19325261334068486,
+    0.19325261334068378, 0.11784918420649983, -0.23923508393305215, -0.024504285082390095,
+    0.2487961816680492, -0.072571169313614445, -0.22048031608708921, 0.15859832104091084,
+    0.14892482612310837, -0.23538601629575517, -0.012266918581854507, 0.24250781329863602,
+    -0.12852568604830536, -0.16788973871175453, 0.22599732328086075, 0.036682618613840451,
+    -0.24729412749119528, 0.10688877335757004, 0.18523778133874003, -0.21443215250006792,
+    -0.060745044975815989, 0.2496988640512931, -0.084222463348054485, -0.20080188287016146,
+    0.2008018828701611, 0.084222463348055041, -0.24969886405129307, 0.060745044975816287,
+    0.21443215250006822, -0.18523778133873903, -0.10688877335757055, 0.24729412749119514,
+    -0.036682618613840749, -0.225997323280861, 0.16788973871175378, 0.12852568604830547,
+    -0.24250781329863583, 0.012266918581854814, 0.23538601629575534, -0.14892482612310745,
+    0.13889255825490057, -0.24519632010080761, 0.048772580504032076, 0.20786740307563636,
+    -0.20786740307563628, -0.048772580504032007, 0.24519632010080766, -0.13889255825490038,
+    -0.13889255825490066, 0.24519632010080761, -0.048772580504032145, -0.20786740307563623,
+    0.20786740307563595, 0.048772580504032589, -0.24519632010080769, 0.13889255825490027,
+    0.13889255825490152, -0.24519632010080741, 0.048772580504031118, 0.20786740307563678,
+    -0.20786740307563586, -0.048772580504032742, 0.24519632010080772, -0.13889255825490013,
+    -0.13889255825490091, 0.24519632010080755, -0.04877258050403184, -0.20786740307563639,
+    0.20786740307563628, 0.04877258050403202, -0.24519632010080758, 0.13889255825490074,
+    0.12852568604830542, -0.2496988640512931, 0.10688877335757054, 0.14892482612310831,
+    -0.24729412749119525, 0.084222463348055054, 0.16788973871175455, -0.24250781329863602,
+    0.060745044975815607, 0.18523778133874003, -0.23538601629575506, 0.036682618613840083,
+    0.20080188287016143, -0.2259973232808607, 0.012266918581854171, 0.2144321525000682,
+    -0.21443215250006739, -0.012266918581854813, 0.22599732328086133, -0.20080188287016104,
+    -0.036682618613841603, 0.23538601629575528, -0.185237781338739, -0.060745044975816231,
+    0.24250781329863627, -0.16788973871175442, -0.084222463348056081, 0.24729412749119528,
+    -0.14892482612310745, -0.10688877335757072, 0.24969886405129316, -0.12852568604830372,
+    0.11784918420649945, -0.24879618166804923, 0.1585983210409114, 0.072571169313615638,
+    -0.23923508393305218, 0.19325261334068425, 0.024504285082390203, -0.22048031608708904,
+    0.22048031608708887, -0.024504285082390311, -0.19325261334068419, 0.23923508393305221,
+    -0.072571169313615527, -0.15859832104091148, 0.2487961816680492, -0.11784918420649837,
+    -0.11784918420649897, 0.24879618166804918, -0.15859832104091165, -0.072571169313615319,
+    0.23923508393305215, -0.19325261334068433, -0.024504285082390095, 0.22048031608708876,
+    -0.22048031608708871, 0.024504285082389974, 0.19325261334068439, -0.23923508393305212,
+    0.072571169313615208, 0.15859832104091176, -0.24879618166804898, 0.11784918420649729,
+    0.10688877335757055, -0.24250781329863599, 0.20080188287016126, -0.012266918581854386,
+    -0.18523778133873997, 0.24729412749119525, -0.1285256860483053, -0.084222463348054888,
+    0.2353860162957552, -0.21443215250006792, 0.036682618613840083, 0.16788973871175497,
+    -0.24969886405129307, 0.14892482612310837, 0.060745044975816939, -0.22599732328086095,
+    0.22599732328086103, -0.060745044975815399, -0.14892482612310823, 0.24969886405129316,
+    -0.16788973871175447, -0.036682618613841658, 0.21443215250006828, -0.23538601629575526,
+    0.084222463348054236, 0.12852568604830553, -0.24729412749119542, 0.1852377813387395,
+    0.012266918581854202, -0.20080188287016168, 0.24250781329863555, -0.10688877335757116,
+    0.095670858091272459, -0.23096988312782171, 0.23096988312782163, -0.095670858091272473,
+    -0.09567085809127264, 0.23096988312782168, -0.2309698831278216, 0.09567085809127239,
+    0.095670858091272723, -0.23096988312782191, 0.23096988312782171, -0.095670858091272307,
+    -0.095670858091272806, 0.23096988312782193, -0.23096988312782135, 0.095670858091271391,
+    0.095670858091272071, -0.23096988312782163, 0.23096988312782166, -0.095670858091272126,
+    -0.095670858091272987, 0.23096988312782202, -0.23096988312782127, 0.095670858091271224,
+    0.095670858091272251, -0.23096988312782171, 0.23096988312782157, -0.095670858091270322,
+    -0.095670858091273153, 0.23096988312782141, -0.23096988312782121, 0.095670858091272695,
+    0.084222463348055013, -0.21443215250006803, 0.24729412749119523, -0.16788973871175442,
+    0.012266918581854355, 0.14892482612310837, -0.24250781329863608, 0.22599732328086072,
+    -0.10688877335757001, -0.060745044975815989, 0.20080188287016143, -0.24969886405129307,
+    0.18523778133873969, -0.036682618613840874, -0.12852568604830611, 0.23538601629575526,
+    -0.23538601629575531, 0.12852568604830469, 0.036682618613840749, -0.18523778133873961,
+    0.24969886405129316, -0.20080188287016099, 0.060745044975816107, 0.10688877335757149,
+    -0.22599732328086106, 0.24250781329863602, -0.14892482612310881, -0.012266918581856892,
+    0.16788973871175597, -0.24729412749119542, 0.21443215250006764, -0.08422246334805486,
+    0.072571169313615583, -0.19325261334068428, 0.24879618166804923, -0.22048031608708871,
+    0.11784918420649934, 0.024504285082390203, -0.1585983210409114, 0.23923508393305234,
+    -0.23923508393305223, 0.15859832104091109, -0.024504285082390248, -0.11784918420649969,
+    0.2204803160870891, -0.2487961816680492, 0.1932526133406838, -0.072571169313614556,
+    -0.072571169313615319, 0.19325261334068433, -0.24879618166804929, 0.22048031608708832,
+    -0.1178491842064982, -0.024504285082390158, 0.15859832104091171, -0.23923508393305246,
+    0.23923508393305185, -0.1585983210409101, 0.024504285082388087, 0.11784918420649847,
+    -0.22048031608708846, 0.24879618166804923, -0.19325261334068414, 0.072571169313615028,
+    0.060745044975815995, -0.16788973871175467, 0.23538601629575523, -0.24729412749119525,
+    0.20080188287016121, -0.10688877335757045, -0.01226691858185463, 0.12852568604830597,
+    -0.21443215250006814, 0.2496988640512931, -0.2259973232808607, 0.14892482612310837,
+    -0.036682618613840874, -0.084222463348055901, 0.18523778133874014, -0.24250781329863605,
+    0.24250781329863605, -0.185237781338739, 0.084222463348054291, 0.036682618613840812,
+    -0.14892482612310834, 0.22599732328086142, -0.24969886405129305, 0.21443215250006772,
+    -0.12852568604830372, 0.012266918581854691, 0.1068887733575716, -0.20080188287016065,
+    0.24729412749119531, -0.23538601629575459, 0.16788973871175486, -0.060745044975814982,
+    0.048772580504032083, -0.13889255825490054, 0.20786740307563636, -0.24519632010080766,
+    0.24519632010080761, -0.20786740307563625, 0.13889255825490038, -0.048772580504032145,
+    -0.048772580504032562, 0.13889255825490071, -0.20786740307563625, 0.24519632010080772,
+    -0.24519632010080741, 0.20786740307563639, -0.13889255825490018, 0.048772580504031063,
+    0.048772580504031902, -0.13889255825490091, 0.20786740307563686, -0.24519632010080758,
+    0.24519632010080752, -0.20786740307563578, 0.13889255825490074, -0.048772580504031722,
+    -0.048772580504031243, 0.13889255825490182, -0.20786740307563648, 0.24519632010080744,
+    -0.24519632010080733, 0.20786740307563614, -0.13889255825490129, 0.04877258050403064,
+    0.036682618613840437, -0.10688877335757062, 0.16788973871175469, -0.21443215250006809,
+    0.24250781329863608, -0.2496988640512931, 0.23538601629575509, -0.20080188287016115,
+    0.14892482612310842, -0.084222463348054485, 0.012266918581854171, 0.060745044975816939,
+    -0.12852568604830611, 0.18523778133874014, -0.22599732328086097, 0.24729412749119525,
+    -0.24729412749119525, 0.22599732328086097, -0.18523778133873894, 0.12852568604830458,
+    -0.060745044975815218, -0.012266918581855057, 0.084222463348055332, -0.14892482612310842,
+    0.20080188287016115, -0.23538601629575509, 0.24969886405129307, -0.24250781329863619,
+    0.2144321525000667, -0.16788973871175286, 0.10688877335756862, -0.03668261861383857,
+    0.024504285082390193, -0.072571169313615611, 0.11784918420649949, -0.15859832104091134,
+    0.19325261334068441, -0.22048031608708904, 0.23923508393305234, -0.24879618166804926,
+    0.2487961816680492, -0.23923508393305221, 0.22048031608708882, -0.19325261334068439,
+    0.15859832104091098, -0.11784918420649831, 0.072571169313615375, -0.024504285082389183,
+    -0.024504285082390095, 0.072571169313616263, -0.11784918420649912, 0.15859832104091171,
+    -0.19325261334068497, 0.22048031608708882, -0.23923508393305196, 0.2487961816680492,
+    -0.24879618166804915, 0.23923508393305182, -0.22048031608708776, 0.19325261334068466,
+    -0.15859832104091132, 0.11784918420649869, -0.072571169313614084, 0.024504285082387844,
+    0.012266918581854531, -0.036682618613840576, 0.060745044975816058, -0.084222463348055249,
+    0.1068887733575707, -0.12852568604830594, 0.14892482612310876, -0.16788973871175497,
+    0.18523778133874005, -0.20080188287016146, 0.2144321525000682, -0.22599732328086095,
+    0.23538601629575526, -0.24250781329863605, 0.24729412749119525, -0.2496988640512931,
+    0.2496988640512931, -0.24729412749119525, 0.24250781329863602, -0.23538601629575526,
+    0.22599732328086092, -0.21443215250006814, 0.20080188287016035, -0.18523778133874003,
+    0.16788973871175361, -0.14892482612310873, 0.12852568604830436, -0.10688877335757105,
+    0.084222463348053944, -0.060745044975816648, 0.036682618613839417, -0.012266918581855303,
+  } ;
+
+static const short zigzag_32[1024] =
+  {
+    0, 1, 32, 64, 33, 2, 3, 34, 65, 96, 128, 97, 66, 35, 4, 5,
+    36, 67, 98, 129, 160, 192, 161, 130, 99, 68, 37, 6, 7, 38, 69, 100,
+    131, 162, 193, 224, 256, 225, 194, 163, 132, 101, 70, 39, 8, 9, 40, 71,
+    102, 133, 164, 195, 226, 257, 288, 320, 289, 258, 227, 196, 165, 134, 103, 72,
+    41, 10, 11, 42, 73, 104, 135, 166, 197, 228, 259, 290, 321, 352, 384, 353,
+    322, 291, 260, 229, 198, 167, 136, 105, 74, 43, 12, 13, 44, 75, 106, 137,
+    168, 199, 230, 261, 292, 323, 354, 385, 416, 448, 417, 386, 355, 324, 293, 262,
+    231, 200, 169, 138, 107, 76, 45, 14, 15, 46, 77, 108, 139, 170, 201, 232,
+    263, 294, 325, 356, 387, 418, 449, 480, 512, 481, 450, 419, 388, 357, 326, 295,
+    264, 233, 202, 171, 140, 109, 78, 47, 16, 17, 48, 79, 110, 141, 172, 203,
+    234, 265, 296, 327, 358, 389, 420, 451, 482, 513, 544, 576, 545, 514, 483, 452,
+    421, 390, 359, 328, 297, 266, 235, 204, 173, 142, 111, 80, 49, 18, 19, 50,
+    81, 112, 143, 174, 205, 236, 267, 298, 329, 360, 391, 422, 453, 484, 515, 546,
+    577, 608, 640, 609, 578, 547, 516, 485, 454, 423, 392, 361, 330, 299, 268, 237,
+    206, 175, 144, 113, 82, 51, 20, 21, 52, 83, 114, 145, 176, 207, 238, 269,
+    300, 331, 362, 393, 424, 455, 486, 517, 548, 579, 610, 641, 672, 704, 673, 642,
+    611, 580, 549, 518, 487, 456, 425, 394, 363, 332, 301, 270, 239, 208, 177, 146,
+    115, 84, 53, 22, 23, 54, 85, 116, 147, 178, 209, 240, 271, 302, 333, 364,
+    395, 426, 457, 488, 519, 550, 581, 612, 643, 674, 705, 736, 768, 737, 706, 675,
+    644, 613, 582, 551, 520, 489, 458, 427, 396, 365, 334, 303, 272, 241, 210, 179,
+    148, 117, 86, 55, 24, 25, 56, 87, 118, 149, 180, 211, 242, 273, 304, 335,
+    366, 397, 428, 459, 490, 521, 552, 583, 614, 645, 676, 707, 738, 769, 800, 832,
+    801, 770, 739, 708, 677, 646, 615, 584, 553, 522, 491, 460, 429, 398, 367, 336,
+    305, 274, 243, 212, 181, 150, 119, 88, 57, 26, 27, 58, 89, 120, 151, 182,
+    213, 244, 275, 306, 337, 368, 399, 430, 461, 492, 523, 554, 585, 616, 647, 678,
+    709, 740, 771, 802, 833, 864, 896, 865, 834, 803, 772, 741, 710, 679, 648, 617,
+    586, 555, 524, 493, 462, 431, 400, 369, 338, 307, 276, 245, 214, 183, 152, 121,
+    90, 59, 28, 29, 60, 91, 122, 153, 184, 215, 246, 277, 308, 339, 370, 401,
+    432, 463, 494, 525, 556, 587, 618, 649, 680, 711, 742, 773, 804, 835, 866, 897,
+    928, 960, 929, 898, 867, 836, 805, 774, 743, 712, 681, 650, 619, 588, 557, 526,
+    495, 464, 433, 402, 371, 340, 309, 278, 247, 216, 185, 154, 123, 92, 61, 30,
+    31, 62, 93, 124, 155, 186, 217, 248, 279, 310, 341, 372, 403, 434, 465, 496,
+    527, 558, 589, 620, 651, 682, 713, 744, 775, 806, 837, 868, 899, 930, 961, 992,
+    993, 962, 931, 900, 869, 838, 807, 776, 745, 714, 683, 652, 621, 590, 559, 528,
+    497, 466, 435, 404, 373, 342, 311, 280, 249, 218, 187, 156, 125, 94, 63, 95,
+    126, 157, 188, 219, 250, 281, 312, 343, 374, 405, 436, 467, 498, 529, 560, 591,
+    622, 653, 684, 715, 746, 777, 808, 839, 870, 901, 932, 963, 994, 995, 964, 933,
+    902, 871, 840, 809, 778, 747, 716, 685, 654, 623, 592, 561, 530, 499, 468, 437,
+    406, 375, 344, 313, 282, 251, 220, 189, 158, 127, 159, 190, 221, 252, 283, 314,
+    345, 376, 407, 438, 469, 500, 531, 562, 593, 624, 655, 686, 717, 748, 779, 810,
+    841, 872, 903, 934, 965, 996, 997, 966, 935, 904, 873, 842, 811, 780, 749, 718,
+    687, 656, 625, 594, 563, 532, 501, 470, 439, 408, 377, 346, 315, 284, 253, 222,
+    191, 223, 254, 285, 316, 347, 378, 409, 440, 471, 502, 533, 564, 595, 626, 657,
+    688, 719, 750, 781, 812, 843, 874, 905, 936, 967, 998, 999, 968, 937, 906, 875,
+    844, 813, 782, 751, 720, 689, 658, 627, 596, 565, 534, 503, 472, 441, 410, 379,
+    348, 317, 286, 255, 287, 318, 349, 380, 411, 442, 473, 504, 535, 566, 597, 628,
+    659, 690, 721, 752, 783, 814, 845, 876, 907, 938, 969, 1000, 1001, 970, 939, 908,
+    877, 846, 815, 784, 753, 722, 691, 660, 629, 598, 567, 536, 505, 474, 443, 412,
+    381, 350, 319, 351, 382, 413, 444, 475, 506, 537, 568, 599, 630, 661, 692, 723,
+    754, 785, 816, 847, 878, 909, 940, 971, 1002, 1003, 972, 941, 910, 879, 848, 817,
+    786, 755, 724, 693, 662, 631, 600, 569, 538, 507, 476, 445, 414, 383, 415, 446,
+    477, 508, 539, 570, 601, 632, 663, 694, 725, 756, 787, 818, 849, 880, 911, 942,
+    973, 1004, 1005, 974, 943, 912, 881, 850, 819, 788, 757, 726, 695, 664, 633, 602,
+    571, 540, 509, 478, 447, 479, 510, 541, 572, 603, 634, 665, 696, 727, 758, 789,
+    820, 851, 882, 913, 944, 975, 1006, 1007, 976, 945, 914, 883, 852, 821, 790, 759,
+    728, 697, 666, 635, 604, 573, 542, 511, 543, 574, 605, 636, 667, 698, 729, 760,
+    791, 822, 853, 884, 915, 946, 977, 1008, 1009, 978, 947, 916, 885, 854, 823, 792,
+    761, 730, 699, 668, 637, 606, 575, 607, 638, 669, 700, 731, 762, 793, 824, 855,
+    886, 917, 948, 979, 1010, 1011, 980, 949, 918, 887, 856, 825, 794, 763, 732, 701,
+    670, 639, 671, 702, 733, 764, 795, 826, 857, 888, 919, 950, 981, 1012, 1013, 982,
+    951, 920, 889, 858, 827, 796, 765, 734, 703, 735, 766, 797, 828, 859, 890, 921,
+    952, 983, 1014, 1015, 984, 953, 922, 891, 860, 829, 798, 767, 799, 830, 861, 892,
+    923, 954, 985, 1016, 1017, 986, 955, 924, 893, 862, 831, 863, 894, 925, 956, 987,
+    1018, 1019, 988, 957, 926, 895, 927, 958, 989, 1020, 1021, 990, 959, 991, 1022, 1023,
+  } ;
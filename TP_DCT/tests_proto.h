@@ -15,25 +15,76 @@ void get_entier_tst() ;
 void put_entier_signe_tst() ;
 void get_entier_signe_tst() ;
 void open_shannon_fano_tst() ;
+void open_shannon_fano_fichier_tst() ;
 void close_shannon_fano_tst() ;
 void put_entier_shannon_fano_tst() ;
 void get_entier_shannon_fano_tst() ;
+void sf_vieillissement_tst() ;
+void sf_apprend_tst() ;
+void sf_sauve_tst() ;
+void sf_clone_tst() ;
+void sf_snapshot_tst() ;
+void sf_restore_tst() ;
 void allocation_matrice_float_tst() ;
 void liberation_matrice_float_tst() ;
+void produit_matrices_float_tst() ;
+void vue_matrice_tst() ;
+void produit_vues_tst() ;
+void transposition_vue_tst() ;
+void transposition_matrice_partielle_tst() ;
+void produit_matrice_vecteur_tst() ;
+void open_arene_tst() ;
+void close_arene_tst() ;
+void arene_taille_matrice_tst() ;
+void arene_matrice_tst() ;
+void arene_rend_tst() ;
+void arene_vue_tst() ;
+void arene_rend_vue_tst() ;
+void arene_reserve_tst() ;
+void arene_session_tst() ;
+void puissance_de_2_tst() ;
+void open_fft_tst() ;
+void close_fft_tst() ;
+void fft_tst() ;
+void open_mdct_tst() ;
+void close_mdct_tst() ;
+void mdct_tst() ;
 void coef_dct_tst() ;
 void dct_tst() ;
+void open_dct_plan_tst() ;
+void close_dct_plan_tst() ;
+void dct_plan_tst() ;
+void dct_plan_applique_tst() ;
+void dct_plan_matrice_tst() ;
 void psycho_tst() ;
+void psycho_paires_tst() ;
+void psycho_bark_tst() ;
+void open_psycho_temporel_tst() ;
+void close_psycho_temporel_tst() ;
+void psycho_temporel_tst() ;
 void compresse_tst() ;
 void decompresse_tst() ;
+void compresse_jpeg_tst() ;
+void compresse_jpeg_fin_tst() ;
+void decompresse_jpeg_tst() ;
 void lire_ligne_tst() ;
 void allocation_image_tst() ;
 void liberation_image_tst() ;
 void lecture_image_tst() ;
 void ecriture_image_tst() ;
 void dct_image_tst() ;
+void dct_vue_tst() ;
+void dct_bande_tst() ;
+void dct_quantification_bande_tst() ;
+void dct_masque_tst() ;
+void dct_elaguee_bande_tst() ;
 void quantification_tst() ;
+void quantification_vue_tst() ;
 void zigzag_tst() ;
+void zigzag_bloc_tst() ;
 void ondelette_1d_tst() ;
 void ondelette_2d_tst() ;
+void ondelette_2d_vue_tst() ;
 void ondelette_1d_inverse_tst() ;
 void ondelette_2d_inverse_tst() ;
+void ondelette_2d_inverse_vue_tst() ;
@@ -15,25 +15,76 @@
 { "put_entier_signe", put_entier_signe_tst },
 { "get_entier_signe", get_entier_signe_tst },
 { "open_shannon_fano", open_shannon_fano_tst },
+{ "open_shannon_fano_fichier", open_shannon_fano_fichier_tst },
 { "close_shannon_fano", close_shannon_fano_tst },
 { "put_entier_shannon_fano", put_entier_shannon_fano_tst },
 { "get_entier_shannon_fano", get_entier_shannon_fano_tst },
+{ "sf_vieillissement", sf_vieillissement_tst },
+{ "sf_apprend", sf_apprend_tst },
+{ "sf_sauve", sf_sauve_tst },
+{ "sf_clone", sf_clone_tst },
+{ "sf_snapshot", sf_snapshot_tst },
+{ "sf_restore", sf_restore_tst },
 { "allocation_matrice_float", allocation_matrice_float_tst },
 { "liberation_matrice_float", liberation_matrice_float_tst },
+{ "produit_matrices_float", produit_matrices_float_tst },
+{ "vue_matrice", vue_matrice_tst },
+{ "produit_vues", produit_vues_tst },
+{ "transposition_vue", transposition_vue_tst },
+{ "transposition_matrice_partielle", transposition_matrice_partielle_tst },
+{ "produit_matrice_vecteur", produit_matrice_vecteur_tst },
+{ "open_arene", open_arene_tst },
+{ "close_arene", close_arene_tst },
+{ "arene_taille_matrice", arene_taille_matrice_tst },
+{ "arene_matrice", arene_matrice_tst },
+{ "arene_rend", arene_rend_tst },
+{ "arene_vue", arene_vue_tst },
+{ "arene_rend_vue", arene_rend_vue_tst },
+{ "arene_reserve", arene_reserve_tst },
+{ "arene_session", arene_session_tst },
+{ "puissance_de_2", puissance_de_2_tst },
+{ "open_fft", open_fft_tst },
+{ "close_fft", close_fft_tst },
+{ "fft", fft_tst },
+{ "open_mdct", open_mdct_tst },
+{ "close_mdct", close_mdct_tst },
+{ "mdct", mdct_tst },
 { "coef_dct", coef_dct_tst },
 { "dct", dct_tst },
+{ "open_dct_plan", open_dct_plan_tst },
+{ "close_dct_plan", close_dct_plan_tst },
+{ "dct_plan", dct_plan_tst },
+{ "dct_plan_applique", dct_plan_applique_tst },
+{ "dct_plan_matrice", dct_plan_matrice_tst },
 { "psycho", psycho_tst },
+{ "psycho_paires", psycho_paires_tst },
+{ "psycho_bark", psycho_bark_tst },
+{ "open_psycho_temporel", open_psycho_temporel_tst },
+{ "close_psycho_temporel", close_psycho_temporel_tst },
+{ "psycho_temporel", psycho_temporel_tst },
 { "compresse", compresse_tst },
 { "decompresse", decompresse_tst },
+{ "compresse_jpeg", compresse_jpeg_tst },
+{ "compresse_jpeg_fin", compresse_jpeg_fin_tst },
+{ "decompresse_jpeg", decompresse_jpeg_tst },
 { "lire_ligne", lire_ligne_tst },
 { "allocation_image", allocation_image_tst },
 { "liberation_image", liberation_image_tst },
 { "lecture_image", lecture_image_tst },
 { "ecriture_image", ecriture_image_tst },
 { "dct_image", dct_image_tst },
+{ "dct_vue", dct_vue_tst },
+{ "dct_bande", dct_bande_tst },
+{ "dct_quantification_bande", dct_quantification_bande_tst },
+{ "dct_masque", dct_masque_tst },
+{ "dct_elaguee_bande", dct_elaguee_bande_tst },
 { "quantification", quantification_tst },
+{ "quantification_vue", quantification_vue_tst },
 { "zigzag", zigzag_tst },
+{ "zigzag_bloc", zigzag_bloc_tst },
 { "ondelette_1d", ondelette_1d_tst },
 { "ondelette_2d", ondelette_2d_tst },
+{ "ondelette_2d_vue", ondelette_2d_vue_tst },
 { "ondelette_1d_inverse", ondelette_1d_inverse_tst },
 { "ondelette_2d_inverse", ondelette_2d_inverse_tst },
+{ "ondelette_2d_inverse_vue", ondelette_2d_inverse_vue_tst },